@@ -2,9 +2,27 @@
 #define BENGINE_hpp
 
 #include "bengine_texture.hpp"
+#include "bengine_texture_atlas.hpp"
+#include "bengine_texture_loader.hpp"
+#include "bengine_font.hpp"
+#include "bengine_text_cache.hpp"
+#include "bengine_camera_2d.hpp"
+#include "bengine_command_buffer.hpp"
+#include "bengine_software_rasterizer.hpp"
 #include "bengine_render_window.hpp"
+#include "bengine_asset_cache.hpp"
+#include "bengine_clock.hpp"
+#include "bengine_event_dispatcher.hpp"
 #include "bengine_mouse.hpp"
+#include "bengine_interpolation.hpp"
+#include "bengine_job_system.hpp"
+#include "bengine_task_scheduler.hpp"
+#include "bengine_work_queue.hpp"
+#include "bengine_subsystem_scheduler.hpp"
+#include "bengine_input_recording.hpp"
 #include "bengine_loop.hpp"
+#include "bengine_triple_buffer.hpp"
+#include "bengine_threaded_loop.hpp"
 #include "bengine_helpers.hpp"
 #include "bengine_small_vector_2d.hpp"
 #include "bengine_fast_vector_2d.hpp"
@@ -0,0 +1,362 @@
+#ifndef BENGINE_ASSET_CACHE_hpp
+#define BENGINE_ASSET_CACHE_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "bengine_render_window.hpp"
+
+namespace bengine {
+    /** Loads textures and fonts at most once per path (and point size, for fonts) and hands out reference-counted handles to them, so that everything using the same file shares one copy
+     *
+     * Textures that nothing holds a handle to anymore stay cached so that loading them again is free, until the textures in the cache take up more GPU memory than the budget allows; then the least recently released ones are destroyed first (textures that are still referenced are never destroyed, even over budget)
+     *
+     * Unreferenced fonts don't take up GPU memory, so they're only closed by bengine::asset_cache::trim or bengine::asset_cache::clear
+     *
+     * Handles need to be dropped before the cache is destroyed, and the cache before its window (bengine::loop owns one that's set up that way)
+     */
+    class asset_cache {
+        private:
+            // \brief A cached texture
+            struct texture_asset {
+                // \brief The texture
+                SDL_Texture *texture;
+                // \brief Roughly how much GPU memory the texture takes up (bytes)
+                std::size_t bytes;
+                // \brief How many handles refer to the texture
+                unsigned int references;
+                // \brief When the texture was last released (compared with bengine::asset_cache::release_clock)
+                unsigned long long last_release;
+            };
+            // \brief A cached font
+            struct font_asset {
+                // \brief The font
+                TTF_Font *font;
+                // \brief How many handles refer to the font
+                unsigned int references;
+            };
+
+        public:
+            // \brief A reference to a cached texture; the texture stays loaded for as long as any handle to it exists
+            class texture_handle {
+                private:
+                    // \brief The cache that the texture belongs to
+                    bengine::asset_cache *cache = NULL;
+                    // \brief The texture (NULL for an empty handle)
+                    bengine::asset_cache::texture_asset *asset = NULL;
+
+                public:
+                    /** bengine::asset_cache::texture_handle constructor (use bengine::asset_cache::load_texture to get a handle that refers to something)
+                     * \param cache The cache that the texture belongs to
+                     * \param asset The texture, whose reference count has already been incremented
+                     */
+                    texture_handle(bengine::asset_cache *cache = NULL, bengine::asset_cache::texture_asset *asset = NULL) : cache(cache), asset(asset) {}
+                    texture_handle(const bengine::asset_cache::texture_handle &rhs) : cache(rhs.cache), asset(rhs.asset) {
+                        if (this->asset != NULL) {
+                            this->asset->references++;
+                        }
+                    }
+                    texture_handle(bengine::asset_cache::texture_handle &&rhs) : cache(rhs.cache), asset(rhs.asset) {
+                        rhs.cache = NULL;
+                        rhs.asset = NULL;
+                    }
+                    bengine::asset_cache::texture_handle& operator=(bengine::asset_cache::texture_handle rhs) {
+                        std::swap(this->cache, rhs.cache);
+                        std::swap(this->asset, rhs.asset);
+                        return *this;
+                    }
+                    // \brief bengine::asset_cache::texture_handle deconstructor; releases the handle's reference
+                    ~texture_handle() {
+                        this->reset();
+                    }
+
+                    // \brief Release the handle's reference and make it empty
+                    void reset() {
+                        if (this->asset != NULL) {
+                            this->cache->release_texture(*this->asset);
+                        }
+                        this->cache = NULL;
+                        this->asset = NULL;
+                    }
+                    /** Get the texture
+                     * \returns The texture (the cache keeps ownership of it), or NULL for an empty handle
+                     */
+                    SDL_Texture* get() const {
+                        return this->asset == NULL ? NULL : this->asset->texture;
+                    }
+                    /** Check whether the handle refers to a texture
+                     * \returns Whether the handle refers to a texture
+                     */
+                    bool is_valid() const {
+                        return this->asset != NULL;
+                    }
+                    /** Point a bengine::basic_texture (or a bengine::modded_texture or bengine::shifting_texture) at the cached texture without giving it ownership; the handle has to outlive it
+                     * \tparam texture_type bengine::basic_texture or one of its subclasses
+                     * \param texture The texture wrapper to point at the cached texture
+                     */
+                    template <class texture_type> void attach(texture_type &texture) const {
+                        texture.set_texture(this->get());
+                        texture.set_ownership(false);
+                    }
+            };
+            // \brief A reference to a cached font; the font stays open for as long as any handle to it exists
+            class font_handle {
+                private:
+                    // \brief The font (NULL for an empty handle)
+                    bengine::asset_cache::font_asset *asset = NULL;
+
+                public:
+                    /** bengine::asset_cache::font_handle constructor (use bengine::asset_cache::load_font to get a handle that refers to something)
+                     * \param asset The font, whose reference count has already been incremented
+                     */
+                    font_handle(bengine::asset_cache::font_asset *asset = NULL) : asset(asset) {}
+                    font_handle(const bengine::asset_cache::font_handle &rhs) : asset(rhs.asset) {
+                        if (this->asset != NULL) {
+                            this->asset->references++;
+                        }
+                    }
+                    font_handle(bengine::asset_cache::font_handle &&rhs) : asset(rhs.asset) {
+                        rhs.asset = NULL;
+                    }
+                    bengine::asset_cache::font_handle& operator=(bengine::asset_cache::font_handle rhs) {
+                        std::swap(this->asset, rhs.asset);
+                        return *this;
+                    }
+                    // \brief bengine::asset_cache::font_handle deconstructor; releases the handle's reference
+                    ~font_handle() {
+                        this->reset();
+                    }
+
+                    // \brief Release the handle's reference and make it empty
+                    void reset() {
+                        if (this->asset != NULL) {
+                            this->asset->references--;
+                        }
+                        this->asset = NULL;
+                    }
+                    /** Get the font
+                     * \returns The font (the cache keeps ownership of it), or NULL for an empty handle
+                     */
+                    TTF_Font* get() const {
+                        return this->asset == NULL ? NULL : this->asset->font;
+                    }
+                    /** Check whether the handle refers to a font
+                     * \returns Whether the handle refers to a font
+                     */
+                    bool is_valid() const {
+                        return this->asset != NULL;
+                    }
+            };
+
+        private:
+            // \brief The window that textures are loaded into and that renders text with the fonts
+            bengine::render_window &window;
+            // \brief Every cached texture keyed by path
+            std::unordered_map<std::string, bengine::asset_cache::texture_asset> textures;
+            // \brief Every cached font keyed by path and point size
+            std::unordered_map<std::string, bengine::asset_cache::font_asset> fonts;
+
+            // \brief How much GPU memory the cached textures are allowed to take up before unreferenced ones get destroyed (bytes)
+            std::size_t budget = 256 * 1024 * 1024;
+            // \brief How much GPU memory the cached textures take up (bytes)
+            std::size_t used = 0;
+            // \brief Counts texture releases to find the least recently released texture
+            unsigned long long release_clock = 0;
+
+            // \brief How many loads were served from the cache
+            unsigned long long hits = 0;
+            // \brief How many loads had to go to the disk
+            unsigned long long misses = 0;
+            // \brief How many unreferenced textures have been destroyed to stay under the budget
+            unsigned long long evictions = 0;
+
+            /** Drop a reference to a texture, destroying unreferenced textures if the cache is over its budget
+             * \param asset The texture
+             */
+            void release_texture(bengine::asset_cache::texture_asset &asset) {
+                asset.references--;
+                asset.last_release = ++this->release_clock;
+                this->enforce_budget();
+            }
+            // \brief Destroy the least recently released unreferenced textures until the cache is within its budget (or nothing else can be destroyed)
+            void enforce_budget() {
+                while (this->used > this->budget) {
+                    auto oldest = this->textures.end();
+                    for (auto position = this->textures.begin(); position != this->textures.end(); position++) {
+                        if (position->second.references == 0 && (oldest == this->textures.end() || position->second.last_release < oldest->second.last_release)) {
+                            oldest = position;
+                        }
+                    }
+                    if (oldest == this->textures.end()) {
+                        return;
+                    }
+                    SDL_DestroyTexture(oldest->second.texture);
+                    this->used -= oldest->second.bytes;
+                    this->textures.erase(oldest);
+                    this->evictions++;
+                }
+            }
+
+        public:
+            /** bengine::asset_cache constructor
+             * \param window The window to load textures into and render text with
+             * \param budget How much GPU memory the cached textures are allowed to take up before unreferenced ones get destroyed (bytes)
+             */
+            asset_cache(bengine::render_window &window, const std::size_t &budget = 256 * 1024 * 1024) : window(window), budget(budget) {}
+            asset_cache(const bengine::asset_cache&) = delete;
+            bengine::asset_cache& operator=(const bengine::asset_cache&) = delete;
+            // \brief bengine::asset_cache deconstructor; destroys every cached texture and closes every cached font
+            ~asset_cache() {
+                this->clear();
+            }
+
+            /** Load a texture, or get the one that's already loaded from the same path
+             * \param filepath The path to the image
+             * \returns A handle to the texture (empty if it couldn't be loaded)
+             */
+            bengine::asset_cache::texture_handle load_texture(const std::string &filepath) {
+                auto position = this->textures.find(filepath);
+                if (position != this->textures.end()) {
+                    this->hits++;
+                    position->second.references++;
+                    return bengine::asset_cache::texture_handle(this, &position->second);
+                }
+
+                this->misses++;
+                SDL_Texture *texture = this->window.load_texture(filepath.c_str());
+                if (texture == NULL) {
+                    return bengine::asset_cache::texture_handle();
+                }
+                Uint32 format = SDL_PIXELFORMAT_UNKNOWN;
+                int width = 0, height = 0;
+                SDL_QueryTexture(texture, &format, NULL, &width, &height);
+                const std::size_t bytes = static_cast<std::size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+
+                position = this->textures.emplace(filepath, bengine::asset_cache::texture_asset{texture, bytes, 1, 0}).first;
+                this->used += bytes;
+                this->enforce_budget();
+                return bengine::asset_cache::texture_handle(this, &position->second);
+            }
+            /** Open a font, or get the one that's already open from the same path at the same point size
+             * \param filepath The path to the font
+             * \param size The point size to open the font at
+             * \returns A handle to the font (empty if it couldn't be opened)
+             */
+            bengine::asset_cache::font_handle load_font(const std::string &filepath, const int &size) {
+                const std::string key = filepath + '\n' + std::to_string(size);
+                auto position = this->fonts.find(key);
+                if (position != this->fonts.end()) {
+                    this->hits++;
+                    position->second.references++;
+                    return bengine::asset_cache::font_handle(&position->second);
+                }
+
+                this->misses++;
+                TTF_Font *font = TTF_OpenFont(filepath.c_str(), size);
+                if (font == NULL) {
+                    std::cout << "Failed to open font \"" << filepath << "\" [bengine::asset_cache::load_font]\nTTF Error: " << TTF_GetError() << "\n";
+                    return bengine::asset_cache::font_handle();
+                }
+                position = this->fonts.emplace(key, bengine::asset_cache::font_asset{font, 1}).first;
+                return bengine::asset_cache::font_handle(&position->second);
+            }
+
+            /** Destroy every texture and close every font that nothing holds a handle to
+             * \returns How many assets were destroyed
+             */
+            std::size_t trim() {
+                std::size_t output = 0;
+                for (auto position = this->textures.begin(); position != this->textures.end();) {
+                    if (position->second.references == 0) {
+                        SDL_DestroyTexture(position->second.texture);
+                        this->used -= position->second.bytes;
+                        position = this->textures.erase(position);
+                        output++;
+                    } else {
+                        position++;
+                    }
+                }
+                for (auto position = this->fonts.begin(); position != this->fonts.end();) {
+                    if (position->second.references == 0) {
+                        // Text rendered with the font is cached by its address, which a new font could end up reusing
+                        this->window.get_text_cache().forget_font(position->second.font);
+                        TTF_CloseFont(position->second.font);
+                        position = this->fonts.erase(position);
+                        output++;
+                    } else {
+                        position++;
+                    }
+                }
+                return output;
+            }
+            // \brief Destroy every cached texture and close every cached font, whether or not anything still holds a handle to them (any remaining handles must not be used afterwards)
+            void clear() {
+                for (auto position = this->textures.begin(); position != this->textures.end(); position++) {
+                    SDL_DestroyTexture(position->second.texture);
+                }
+                for (auto position = this->fonts.begin(); position != this->fonts.end(); position++) {
+                    this->window.get_text_cache().forget_font(position->second.font);
+                    TTF_CloseFont(position->second.font);
+                }
+                this->textures.clear();
+                this->fonts.clear();
+                this->used = 0;
+            }
+
+            /** Get how much GPU memory the cached textures are allowed to take up
+             * \returns How much GPU memory the cached textures are allowed to take up (bytes)
+             */
+            std::size_t get_budget() const {
+                return this->budget;
+            }
+            /** Set how much GPU memory the cached textures are allowed to take up, destroying unreferenced textures right away if the cache is now over
+             * \param budget How much GPU memory the cached textures are allowed to take up (bytes)
+             */
+            void set_budget(const std::size_t &budget) {
+                this->budget = budget;
+                this->enforce_budget();
+            }
+            /** Get roughly how much GPU memory the cached textures take up, referenced or not
+             * \returns Roughly how much GPU memory the cached textures take up (bytes)
+             */
+            std::size_t get_used() const {
+                return this->used;
+            }
+            /** Get how many textures are cached
+             * \returns How many textures are cached
+             */
+            std::size_t get_texture_count() const {
+                return this->textures.size();
+            }
+            /** Get how many fonts are cached
+             * \returns How many fonts are cached
+             */
+            std::size_t get_font_count() const {
+                return this->fonts.size();
+            }
+            /** Get how many loads were served from the cache
+             * \returns How many loads were served from the cache
+             */
+            unsigned long long get_hits() const {
+                return this->hits;
+            }
+            /** Get how many loads had to go to the disk
+             * \returns How many loads had to go to the disk
+             */
+            unsigned long long get_misses() const {
+                return this->misses;
+            }
+            /** Get how many unreferenced textures have been destroyed to stay under the budget
+             * \returns How many unreferenced textures have been destroyed to stay under the budget
+             */
+            unsigned long long get_evictions() const {
+                return this->evictions;
+            }
+    };
+}
+
+#endif // BENGINE_ASSET_CACHE_hpp
@@ -0,0 +1,238 @@
+#ifndef BENGINE_CAMERA_2D_hpp
+#define BENGINE_CAMERA_2D_hpp
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+#include "btils_main.hpp"
+
+namespace bengine {
+    /** A view into a 2D world that maps world units to window pixels with a position, zoom, and rotation
+     *
+     * bengine::render_window has overloads of its drawing functions that take a camera first and world coordinates after it; anything the camera can't see is thrown out before it reaches SDL, and bengine::camera_2d::get_view_bounds gives the part of the world that's visible so that big grids can skip straight to the cells in view
+     *
+     * Rotations are counterclockwise like the rest of bengine, and rotating the camera turns the world the other way on screen
+     */
+    class camera_2d {
+        private:
+            // \brief x-position of the point in the world that's in the center of the viewport (world units)
+            double x_pos = 0.0;
+            // \brief y-position of the point in the world that's in the center of the viewport (world units)
+            double y_pos = 0.0;
+            // \brief How many pixels one world unit takes up
+            double zoom = 1.0;
+            // \brief How far the camera is rotated counterclockwise (degrees)
+            double rotation = 0.0;
+            // \brief The sine of the camera's rotation
+            double sine = 0.0;
+            // \brief The cosine of the camera's rotation
+            double cosine = 1.0;
+            // \brief The part of the window that the camera draws into (px, relative to the window's base size)
+            SDL_Rect viewport = {0, 0, 0, 0};
+
+        public:
+            /** bengine::camera_2d constructor
+             * \param viewport The part of the window that the camera draws into (px, relative to the window's base size)
+             * \param zoom How many pixels one world unit takes up
+             */
+            camera_2d(const SDL_Rect &viewport = {0, 0, 0, 0}, const double &zoom = 1.0) {
+                this->viewport = viewport;
+                this->set_zoom(zoom);
+            }
+            /** bengine::camera_2d constructor
+             * \param width The width of the viewport, which starts at the top-left corner of the window (px)
+             * \param height The height of the viewport, which starts at the top-left corner of the window (px)
+             * \param zoom How many pixels one world unit takes up
+             */
+            camera_2d(const int &width, const int &height, const double &zoom = 1.0) : camera_2d(SDL_Rect{0, 0, width, height}, zoom) {}
+            // \brief bengine::camera_2d deconstructor
+            ~camera_2d() {}
+
+            /** Get the x-position of the point in the world that's in the center of the viewport
+             * \returns The x-position of the center of the view (world units)
+             */
+            double get_x_pos() const {
+                return this->x_pos;
+            }
+            /** Get the y-position of the point in the world that's in the center of the viewport
+             * \returns The y-position of the center of the view (world units)
+             */
+            double get_y_pos() const {
+                return this->y_pos;
+            }
+            /** Set the point in the world that's in the center of the viewport
+             * \param x_pos x-position of the center of the view (world units)
+             * \param y_pos y-position of the center of the view (world units)
+             */
+            void set_position(const double &x_pos, const double &y_pos) {
+                this->x_pos = x_pos;
+                this->y_pos = y_pos;
+            }
+            /** Set the point in the world that's in the top-left corner of the viewport (assuming the camera isn't rotated)
+             * \param x_pos x-position of the top-left corner of the view (world units)
+             * \param y_pos y-position of the top-left corner of the view (world units)
+             */
+            void set_top_left(const double &x_pos, const double &y_pos) {
+                this->set_position(x_pos + this->viewport.w / (2.0 * this->zoom), y_pos + this->viewport.h / (2.0 * this->zoom));
+            }
+            /** Move the camera
+             * \param x_comp How far to move the camera horizontally (world units)
+             * \param y_comp How far to move the camera vertically (world units)
+             */
+            void translate(const double &x_comp, const double &y_comp) {
+                this->x_pos += x_comp;
+                this->y_pos += y_comp;
+            }
+            /** Get how many pixels one world unit takes up
+             * \returns How many pixels one world unit takes up
+             */
+            double get_zoom() const {
+                return this->zoom;
+            }
+            /** Set how many pixels one world unit takes up
+             * \param zoom How many pixels one world unit takes up (anything that isn't positive is ignored)
+             */
+            void set_zoom(const double &zoom) {
+                if (zoom > 0.0) {
+                    this->zoom = zoom;
+                }
+            }
+            /** Get how far the camera is rotated
+             * \returns How far the camera is rotated counterclockwise (degrees)
+             */
+            double get_rotation() const {
+                return this->rotation;
+            }
+            /** Set how far the camera is rotated
+             * \param rotation How far to rotate the camera counterclockwise (degrees)
+             */
+            void set_rotation(const double &rotation) {
+                this->rotation = rotation;
+                this->sine = std::sin(btils::degrees_to_radians(rotation));
+                this->cosine = std::cos(btils::degrees_to_radians(rotation));
+            }
+            /** Rotate the camera further
+             * \param angle How far to rotate the camera counterclockwise (degrees)
+             */
+            void rotate(const double &angle) {
+                this->set_rotation(this->rotation + angle);
+            }
+            /** Get the part of the window that the camera draws into
+             * \returns The viewport (px, relative to the window's base size)
+             */
+            SDL_Rect get_viewport() const {
+                return this->viewport;
+            }
+            /** Set the part of the window that the camera draws into
+             * \param viewport The viewport (px, relative to the window's base size)
+             */
+            void set_viewport(const SDL_Rect &viewport) {
+                this->viewport = viewport;
+            }
+
+            /** Find where a point in the world shows up in the window
+             * \param x x-position of the point (world units)
+             * \param y y-position of the point (world units)
+             * \returns The point relative to the window (px)
+             */
+            SDL_FPoint world_to_screen(const double &x, const double &y) const {
+                const double dx = (x - this->x_pos) * this->zoom, dy = (y - this->y_pos) * this->zoom;
+                return {static_cast<float>(this->viewport.x + this->viewport.w / 2.0 + dx * this->cosine - dy * this->sine), static_cast<float>(this->viewport.y + this->viewport.h / 2.0 + dx * this->sine + dy * this->cosine)};
+            }
+            /** Find which point in the world shows up at a point in the window (for turning mouse positions into world positions)
+             * \param x x-position of the point relative to the window (px)
+             * \param y y-position of the point relative to the window (px)
+             * \returns The point in the world (world units)
+             */
+            SDL_FPoint screen_to_world(const double &x, const double &y) const {
+                const double dx = x - this->viewport.x - this->viewport.w / 2.0, dy = y - this->viewport.y - this->viewport.h / 2.0;
+                return {static_cast<float>(this->x_pos + (dx * this->cosine + dy * this->sine) / this->zoom), static_cast<float>(this->y_pos + (dy * this->cosine - dx * this->sine) / this->zoom)};
+            }
+            /** Find the smallest rectangle in the window that a rectangle in the world fits inside of (corners are rounded so that rectangles which share an edge in the world also share one on screen)
+             * \param x x-position of the top-left corner of the rectangle (world units)
+             * \param y y-position of the top-left corner of the rectangle (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \returns The rectangle relative to the window (px for all 4 metrics)
+             */
+            SDL_Rect get_screen_rectangle(const double &x, const double &y, const double &w, const double &h) const {
+                const SDL_FPoint corners[4] = {this->world_to_screen(x, y), this->world_to_screen(x + w, y), this->world_to_screen(x + w, y + h), this->world_to_screen(x, y + h)};
+                float left = corners[0].x, top = corners[0].y, right = corners[0].x, bottom = corners[0].y;
+                for (unsigned char i = 1; i < 4; i++) {
+                    left = std::min(left, corners[i].x);
+                    top = std::min(top, corners[i].y);
+                    right = std::max(right, corners[i].x);
+                    bottom = std::max(bottom, corners[i].y);
+                }
+                const int rounded_left = static_cast<int>(std::lround(left)), rounded_top = static_cast<int>(std::lround(top));
+                return {rounded_left, rounded_top, static_cast<int>(std::lround(right)) - rounded_left, static_cast<int>(std::lround(bottom)) - rounded_top};
+            }
+            /** Get the part of the world that the camera can see (the whole viewport fits inside of it, and when the camera is rotated it covers a bit more than what's visible)
+             * \param left Where to store the left edge of the view (world units)
+             * \param top Where to store the top edge of the view (world units)
+             * \param right Where to store the right edge of the view (world units)
+             * \param bottom Where to store the bottom edge of the view (world units)
+             */
+            void get_view_bounds(double &left, double &top, double &right, double &bottom) const {
+                const double half_w = this->viewport.w / (2.0 * this->zoom), half_h = this->viewport.h / (2.0 * this->zoom);
+                const double extent_x = half_w * std::abs(this->cosine) + half_h * std::abs(this->sine);
+                const double extent_y = half_w * std::abs(this->sine) + half_h * std::abs(this->cosine);
+                left = this->x_pos - extent_x;
+                top = this->y_pos - extent_y;
+                right = this->x_pos + extent_x;
+                bottom = this->y_pos + extent_y;
+            }
+
+            /** Check whether any of a rectangle in the world might be visible (exact when the camera isn't rotated, and never wrong about something that's visible when it is)
+             * \param x x-position of the top-left corner of the rectangle (world units)
+             * \param y y-position of the top-left corner of the rectangle (world units)
+             * \param w Width of the rectangle (world units) (can be negative)
+             * \param h Height of the rectangle (world units) (can be negative)
+             * \returns Whether the rectangle might be visible
+             */
+            bool is_visible(const double &x, const double &y, const double &w, const double &h) const {
+                const double rectangle_left = std::min(x, x + w), rectangle_right = std::max(x, x + w);
+                const double rectangle_top = std::min(y, y + h), rectangle_bottom = std::max(y, y + h);
+                double left, top, right, bottom;
+                this->get_view_bounds(left, top, right, bottom);
+                if (rectangle_right < left || rectangle_left > right || rectangle_bottom < top || rectangle_top > bottom) {
+                    return false;
+                }
+                if (this->sine == 0.0) {
+                    return true;
+                }
+
+                // The view's bounds are loose when it's rotated, so the rectangle also has to overlap the viewport on screen
+                const SDL_FPoint corners[4] = {this->world_to_screen(rectangle_left, rectangle_top), this->world_to_screen(rectangle_right, rectangle_top), this->world_to_screen(rectangle_right, rectangle_bottom), this->world_to_screen(rectangle_left, rectangle_bottom)};
+                float screen_left = corners[0].x, screen_top = corners[0].y, screen_right = corners[0].x, screen_bottom = corners[0].y;
+                for (unsigned char i = 1; i < 4; i++) {
+                    screen_left = std::min(screen_left, corners[i].x);
+                    screen_top = std::min(screen_top, corners[i].y);
+                    screen_right = std::max(screen_right, corners[i].x);
+                    screen_bottom = std::max(screen_bottom, corners[i].y);
+                }
+                return screen_right >= this->viewport.x && screen_left <= this->viewport.x + this->viewport.w && screen_bottom >= this->viewport.y && screen_top <= this->viewport.y + this->viewport.h;
+            }
+            /** Check whether a point in the world is visible
+             * \param x x-position of the point (world units)
+             * \param y y-position of the point (world units)
+             * \returns Whether the point is visible
+             */
+            bool is_visible(const double &x, const double &y) const {
+                const SDL_FPoint point = this->world_to_screen(x, y);
+                return point.x >= this->viewport.x && point.x < this->viewport.x + this->viewport.w && point.y >= this->viewport.y && point.y < this->viewport.y + this->viewport.h;
+            }
+            /** Check whether any of a circle in the world might be visible
+             * \param x x-position of the center of the circle (world units)
+             * \param y y-position of the center of the circle (world units)
+             * \param r Radius of the circle (world units)
+             * \returns Whether the circle might be visible
+             */
+            bool is_circle_visible(const double &x, const double &y, const double &r) const {
+                return this->is_visible(x - std::abs(r), y - std::abs(r), std::abs(r) * 2, std::abs(r) * 2);
+            }
+    };
+}
+
+#endif // BENGINE_CAMERA_2D_hpp
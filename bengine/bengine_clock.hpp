@@ -0,0 +1,183 @@
+#ifndef BENGINE_CLOCK_hpp
+#define BENGINE_CLOCK_hpp
+
+#include <SDL2/SDL.h>
+
+namespace bengine {
+    // \brief A static wrapper around SDL's high-resolution performance counter that measures everything in seconds
+    class precision_clock {
+        public:
+            // \brief bengine::precision_clock constructor
+            precision_clock() {}
+            // \brief bengine::precision_clock deconstructor
+            ~precision_clock() {}
+
+            /** Get the current value of the high-resolution counter
+             * \returns The current value of the high-resolution counter (ticks)
+             */
+            static Uint64 now() {
+                return SDL_GetPerformanceCounter();
+            }
+            /** Get the amount of high-resolution counter ticks that happen per second (fetched from SDL once and then cached)
+             * \returns The amount of counter ticks per second
+             */
+            static Uint64 get_frequency() {
+                static const Uint64 frequency = SDL_GetPerformanceFrequency();
+                return frequency;
+            }
+
+            /** Convert a span of high-resolution counter ticks into seconds
+             * \param ticks The amount of counter ticks
+             * \returns The amount of counter ticks as seconds
+             */
+            static double to_seconds(const Uint64 &ticks) {
+                return static_cast<double>(ticks) / bengine::precision_clock::get_frequency();
+            }
+            /** Convert an amount of seconds into a span of high-resolution counter ticks
+             * \param seconds The amount of seconds (negative values are treated as 0)
+             * \returns The amount of seconds as counter ticks
+             */
+            static Uint64 to_ticks(const double &seconds) {
+                return seconds <= 0 ? 0 : static_cast<Uint64>(seconds * bengine::precision_clock::get_frequency());
+            }
+
+            /** Get the amount of seconds between two counter values
+             * \param start The earlier counter value
+             * \param end The later counter value
+             * \returns The amount of seconds between the two counter values (0 if end comes before start)
+             */
+            static double seconds_between(const Uint64 &start, const Uint64 &end) {
+                return end > start ? bengine::precision_clock::to_seconds(end - start) : 0.0;
+            }
+            /** Get the amount of seconds that have passed since a previous counter value
+             * \param start The earlier counter value
+             * \returns The amount of seconds between the given counter value and now
+             */
+            static double seconds_since(const Uint64 &start) {
+                return bengine::precision_clock::seconds_between(start, bengine::precision_clock::now());
+            }
+    };
+
+    // \brief A frame limiter that sleeps away most of a frame's leftover time and then spins for the remainder so that frames end within tens of microseconds of their deadline
+    class frame_limiter {
+        private:
+            // \brief How long each frame should take (seconds); a value of zero or less disables limiting
+            double target_frame_time = 1.0 / 60.0;
+            // \brief How close to the deadline to stop sleeping and start spinning (seconds); SDL_Delay can overshoot by a millisecond or more, so this should be larger than the scheduler's granularity
+            double spin_threshold = 0.002;
+            // \brief Whether the limiter should spin at all or only sleep (sleeping only is cheaper on power, but less precise)
+            bool spinning = true;
+
+            // \brief The counter value that the current frame should end at
+            Uint64 deadline = 0;
+
+        public:
+            /** bengine::frame_limiter constructor
+             * \param target_frame_time How long each frame should take (seconds); a value of zero or less disables limiting
+             * \param spin_threshold How close to the deadline to stop sleeping and start spinning (seconds)
+             */
+            frame_limiter(const double &target_frame_time = 1.0 / 60.0, const double &spin_threshold = 0.002) {
+                this->set_target_frame_time(target_frame_time);
+                this->set_spin_threshold(spin_threshold);
+            }
+            // \brief bengine::frame_limiter deconstructor
+            ~frame_limiter() {}
+
+            /** Get how long each frame should take (seconds)
+             * \returns How long each frame should take (seconds); a value of zero or less means limiting is disabled
+             */
+            double get_target_frame_time() const {
+                return this->target_frame_time;
+            }
+            /** Set how long each frame should take (seconds)
+             * \param target_frame_time How long each frame should take (seconds); a value of zero or less disables limiting
+             */
+            void set_target_frame_time(const double &target_frame_time) {
+                this->target_frame_time = target_frame_time;
+            }
+            /** Set how long each frame should take using a rate instead of a duration
+             * \param target_rate How many frames should happen every second (Hz); a value of zero or less disables limiting
+             */
+            void set_target_rate(const double &target_rate) {
+                this->target_frame_time = target_rate <= 0 ? 0 : 1.0 / target_rate;
+            }
+
+            /** Get how close to the deadline the limiter will stop sleeping and start spinning (seconds)
+             * \returns How close to the deadline the limiter will stop sleeping and start spinning (seconds)
+             */
+            double get_spin_threshold() const {
+                return this->spin_threshold;
+            }
+            /** Set how close to the deadline the limiter will stop sleeping and start spinning (seconds)
+             * \param spin_threshold How close to the deadline the limiter will stop sleeping and start spinning (seconds)
+             */
+            void set_spin_threshold(const double &spin_threshold) {
+                this->spin_threshold = spin_threshold < 0 ? 0 : spin_threshold;
+            }
+
+            /** Get whether the limiter spins for the last part of each frame or not
+             * \returns Whether the limiter spins for the last part of each frame or not
+             */
+            bool is_spinning() const {
+                return this->spinning;
+            }
+            // \brief Make the limiter spin for the last part of each frame
+            void start_spinning() {
+                this->spinning = true;
+            }
+            // \brief Make the limiter only sleep (cheaper, but less precise)
+            void halt_spinning() {
+                this->spinning = false;
+            }
+
+            // \brief Start timing frames from the current moment (useful after a long pause so that the limiter doesn't try to catch up)
+            void reset() {
+                this->deadline = bengine::precision_clock::now() + bengine::precision_clock::to_ticks(this->target_frame_time);
+            }
+            /** Wait until the current frame's deadline has been reached and then schedule the next one
+             *
+             * Deadlines are scheduled back-to-back rather than from whenever waiting stops so that small overshoots don't accumulate; a frame that runs more than a full frame late resets the schedule instead of trying to make up for it
+             *
+             * \returns How long was spent waiting (seconds)
+             */
+            double wait() {
+                const Uint64 start = bengine::precision_clock::now();
+                if (this->target_frame_time <= 0) {
+                    this->deadline = start;
+                    return 0.0;
+                }
+
+                const Uint64 frame_ticks = bengine::precision_clock::to_ticks(this->target_frame_time);
+                if (this->deadline == 0 || start >= this->deadline + frame_ticks) {
+                    this->deadline = start + frame_ticks;
+                    return 0.0;
+                }
+                if (start >= this->deadline) {
+                    this->deadline += frame_ticks;
+                    return 0.0;
+                }
+
+                // Sleeping is done in whole milliseconds, so only sleep while there is more time left than the spin threshold allows for
+                const Uint64 spin_ticks = this->spinning ? bengine::precision_clock::to_ticks(this->spin_threshold) : 0;
+                Uint64 current = start;
+                while (current < this->deadline && this->deadline - current > spin_ticks) {
+                    const Uint32 sleep_ms = static_cast<Uint32>(bengine::precision_clock::to_seconds(this->deadline - current - spin_ticks) * 1000);
+                    if (sleep_ms == 0) {
+                        break;
+                    }
+                    SDL_Delay(sleep_ms);
+                    current = bengine::precision_clock::now();
+                }
+                if (this->spinning) {
+                    while (current < this->deadline) {
+                        current = bengine::precision_clock::now();
+                    }
+                }
+
+                this->deadline += frame_ticks;
+                return bengine::precision_clock::seconds_between(start, current);
+            }
+    };
+}
+
+#endif // BENGINE_CLOCK_hpp
@@ -0,0 +1,336 @@
+#ifndef BENGINE_COMMAND_BUFFER_hpp
+#define BENGINE_COMMAND_BUFFER_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+#include "bengine_font.hpp"
+#include "bengine_texture.hpp"
+
+namespace bengine {
+    /** A list of draw commands that is recorded now and replayed later by bengine::render_window::replay (or bengine::render_window::submit_command_buffer, which replays it when the window presents)
+     *
+     * Recording never touches SDL, so any thread can fill its own buffer (scene traversal and culling can run on a bengine::job_system while the main thread is still submitting the previous frame); a single buffer isn't safe to record into from more than one thread at once
+     *
+     * Commands are plain data: text is copied into the buffer, but textures, fonts, and render targets are only pointed to, so they have to stay alive until the buffer has been replayed
+     */
+    class command_buffer {
+        public:
+            // \brief What a command draws
+            enum class command_kind : Uint8 {
+                CLEAR,                // command_kind that clears the renderer with color
+                PIXEL,                // command_kind that draws a pixel at (shape.x, shape.y)
+                LINE,                 // command_kind that draws a line from (shape.x, shape.y) to (shape.w, shape.h)
+                RECTANGLE,            // command_kind that draws the outline of shape
+                FILLED_RECTANGLE,     // command_kind that fills shape
+                ELLIPSE,              // command_kind that draws the outline of an ellipse centered at (shape.x, shape.y) with radii (shape.w, shape.h)
+                FILLED_ELLIPSE,       // command_kind that fills an ellipse centered at (shape.x, shape.y) with radii (shape.w, shape.h)
+                TEXTURE,              // command_kind that copies src of texture to shape
+                ROTATED_TEXTURE,      // command_kind that copies src of texture to shape rotated by angle around pivot and flipped by flip
+                TTF_TEXT,             // command_kind that renders text with ttf_font at (shape.x, shape.y) wrapped to shape.w
+                FONT_TEXT,            // command_kind that renders text with font at (shape.x, shape.y) wrapped to shape.w
+                PUSH_TARGET,          // command_kind that pushes the pooled render target target
+                POP_TARGET            // command_kind that pops the most recently pushed render target
+            };
+
+            // \brief One recorded command (which members are used depends on its kind)
+            struct command {
+                // \brief What the command draws
+                bengine::command_buffer::command_kind kind;
+                // \brief Whether an ellipse outline is anti-aliased
+                bool antialiased;
+                // \brief How a rotated texture is flipped
+                SDL_RendererFlip flip;
+                // \brief The layer that the command is drawn on (lower layers are replayed first)
+                int layer;
+                // \brief The color to draw with
+                SDL_Color color;
+                // \brief The command's rectangle, points, or ellipse (see bengine::command_buffer::command_kind)
+                SDL_Rect shape;
+                // \brief The part of the texture to copy
+                SDL_Rect src;
+                // \brief The point that a rotated texture is rotated around relative to the top-left corner of shape
+                SDL_Point pivot;
+                // \brief How far a rotated texture is rotated (degrees)
+                double angle;
+                // \brief Where the command's text starts in bengine::command_buffer::text (it's null-terminated)
+                std::size_t text_start;
+                // \brief The texture, font, or render target that the command uses
+                union {
+                    SDL_Texture *texture;
+                    TTF_Font *ttf_font;
+                    bengine::font *font;
+                    unsigned int target;
+                };
+            };
+
+        private:
+            // \brief The recorded commands in the order they were recorded
+            std::vector<bengine::command_buffer::command> commands;
+            // \brief The text of every text command, one after another with null terminators in between
+            std::u16string text;
+            // \brief The layer that new commands are recorded on
+            int layer = 0;
+
+            /** Start recording a command
+             * \param kind What the command draws
+             * \returns The new command (with everything besides its kind and layer zeroed)
+             */
+            bengine::command_buffer::command& record(const bengine::command_buffer::command_kind &kind) {
+                bengine::command_buffer::command output = {};
+                output.kind = kind;
+                output.layer = this->layer;
+                this->commands.emplace_back(output);
+                return this->commands.back();
+            }
+            /** Copy text into the buffer
+             * \param text The text to copy
+             * \returns Where the text starts in bengine::command_buffer::text
+             */
+            std::size_t store_text(const char16_t *text) {
+                const std::size_t output = this->text.size();
+                this->text.append(text);
+                this->text.push_back(u'\0');
+                return output;
+            }
+
+        public:
+            // \brief bengine::command_buffer constructor
+            command_buffer() {}
+            // \brief bengine::command_buffer deconstructor
+            ~command_buffer() {}
+
+            /** Get the layer that new commands are recorded on
+             * \returns The layer that new commands are recorded on
+             */
+            int get_layer() const {
+                return this->layer;
+            }
+            /** Set the layer that new commands are recorded on; when several buffers are replayed together their commands are merged by layer, and commands on the same layer keep the order of the buffers and then the order they were recorded in
+             * \param layer The layer to record on
+             */
+            void set_layer(const int &layer) {
+                this->layer = layer;
+            }
+
+            /** Record clearing the renderer (see bengine::render_window::clear_renderer)
+             * \param color The color to make the newly blank screen as an SDL_Color
+             */
+            void clear_renderer(const SDL_Color &color = {0, 0, 0, 255}) {
+                this->record(bengine::command_buffer::command_kind::CLEAR).color = color;
+            }
+            /** Record drawing a singular pixel (see bengine::render_window::draw_pixel)
+             * \param x x-position of the pixel to change relative to the window
+             * \param y y-position of the pixel to change relative to the window
+             * \param color The color to change the pixel to as an SDL_Color
+             */
+            void draw_pixel(const int &x, const int &y, const SDL_Color &color = {255, 255, 255, 255}) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::PIXEL);
+                output.shape = {x, y, 0, 0};
+                output.color = color;
+            }
+            /** Record drawing a line (see bengine::render_window::draw_line)
+             * \param x1 x-position of the starting point relative to the window (px)
+             * \param y1 y-position of the starting point relative to the window (px)
+             * \param x2 x-position of the ending point relative to the window (px)
+             * \param y2 y-position of the ending point relative to the window (px)
+             * \param color The color to draw the line with as an SDL_Color
+             */
+            void draw_line(const int &x1, const int &y1, const int &x2, const int &y2, const SDL_Color &color = {255, 255, 255, 255}) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::LINE);
+                output.shape = {x1, y1, x2, y2};
+                output.color = color;
+            }
+            /** Record drawing a rectangle's perimeter (see bengine::render_window::draw_rectangle)
+             * \param x x-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param y y-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param w Width of the rectangle (px)
+             * \param h Height of the rectangle (px)
+             * \param color The color to draw the rectangle with as an SDL_Color
+             */
+            void draw_rectangle(const int &x, const int &y, const int &w, const int &h, const SDL_Color &color = {255, 255, 255, 255}) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::RECTANGLE);
+                output.shape = {x, y, w, h};
+                output.color = color;
+            }
+            /** Record filling a rectangle (see bengine::render_window::fill_rectangle)
+             * \param x x-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param y y-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param w Width of the rectangle (px)
+             * \param h Height of the rectangle (px)
+             * \param color The color to fill the rectangle with as an SDL_Color
+             */
+            void fill_rectangle(const int &x, const int &y, const int &w, const int &h, const SDL_Color &color = {255, 255, 255, 255}) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::FILLED_RECTANGLE);
+                output.shape = {x, y, w, h};
+                output.color = color;
+            }
+            /** Record drawing an ellipse's perimeter (see bengine::render_window::draw_ellipse)
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx Horizontal radius of the ellipse (px)
+             * \param ry Vertical radius of the ellipse (px)
+             * \param color The color to draw the ellipse with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels
+             */
+            void draw_ellipse(const int &x, const int &y, const int &rx, const int &ry, const SDL_Color &color = {255, 255, 255, 255}, const bool &antialiased = false) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::ELLIPSE);
+                output.shape = {x, y, rx, ry};
+                output.color = color;
+                output.antialiased = antialiased;
+            }
+            /** Record filling an ellipse (see bengine::render_window::fill_ellipse)
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx Horizontal radius of the ellipse (px)
+             * \param ry Vertical radius of the ellipse (px)
+             * \param color The color to fill the ellipse with as an SDL_Color
+             */
+            void fill_ellipse(const int &x, const int &y, const int &rx, const int &ry, const SDL_Color &color = {255, 255, 255, 255}) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::FILLED_ELLIPSE);
+                output.shape = {x, y, rx, ry};
+                output.color = color;
+            }
+            /** Record drawing a circle's perimeter (see bengine::render_window::draw_circle)
+             * \param x x-position of the center of the circle relative to the window (px)
+             * \param y y-position of the center of the circle relative to the window (px)
+             * \param r Radius of the circle (px)
+             * \param color The color to draw the circle with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels
+             */
+            void draw_circle(const int &x, const int &y, const int &r, const SDL_Color &color = {255, 255, 255, 255}, const bool &antialiased = false) {
+                this->draw_ellipse(x, y, r, r, color, antialiased);
+            }
+            /** Record filling a circle (see bengine::render_window::fill_circle)
+             * \param x x-position of the center of the circle relative to the window (px)
+             * \param y y-position of the center of the circle relative to the window (px)
+             * \param r Radius of the circle (px)
+             * \param color The color to fill the circle with as an SDL_Color
+             */
+            void fill_circle(const int &x, const int &y, const int &r, const SDL_Color &color = {255, 255, 255, 255}) {
+                this->fill_ellipse(x, y, r, r, color);
+            }
+
+            /** Record rendering an SDL_Texture (see bengine::render_window::render_SDLTexture)
+             * \param texture The SDL_Texture to render (has to stay alive until the buffer is replayed)
+             * \param src The portion of the SDL_Texture to copy and render (px for all 4 metrics)
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics)
+             */
+            void render_SDLTexture(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dst) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::TEXTURE);
+                output.texture = texture;
+                output.src = src;
+                output.shape = dst;
+            }
+            /** Record rendering an SDL_Texture with rotations/reflections (see bengine::render_window::render_SDLTexture)
+             * \param texture The SDL_Texture to render (has to stay alive until the buffer is replayed)
+             * \param src The portion of the SDL_Texture to copy and render (px for all 4 metrics)
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics)
+             * \param angle The angle to rotate the texture (degrees)
+             * \param center The point to rotate around (px for both metrics) relative to the top-left corner of the destination rectangle
+             * \param flip How to flip the rectangle (SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL can be OR'd together)
+             */
+            void render_SDLTexture(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dst, const double &angle, const SDL_Point &center, const SDL_RendererFlip &flip) {
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::ROTATED_TEXTURE);
+                output.texture = texture;
+                output.src = src;
+                output.shape = dst;
+                output.angle = angle;
+                output.pivot = center;
+                output.flip = flip;
+            }
+            /** Record rendering a bengine::basic_texture or bengine::modded_texture (its color modifications live in the SDL_Texture, so they're whatever they are at replay time)
+             * \param texture The texture to render (its SDL_Texture has to stay alive until the buffer is replayed)
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics)
+             */
+            void render_basic_texture(const bengine::basic_texture &texture, const SDL_Rect &dst) {
+                this->render_SDLTexture(texture.get_texture(), texture.get_frame(), dst);
+            }
+            /** Record rendering a bengine::shifting_texture (its rotation/reflection is copied now)
+             * \param texture The texture to render (its SDL_Texture has to stay alive until the buffer is replayed)
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics)
+             */
+            void render_shifting_texture(const bengine::shifting_texture &texture, const SDL_Rect &dst) {
+                this->render_SDLTexture(texture.get_texture(), texture.get_frame(), dst, texture.get_angle(), texture.get_pivot(), texture.get_flip());
+            }
+
+            /** Record rendering text using a TTF_Font (see bengine::render_window::render_text)
+             * \param font The TTF_Font to use (has to stay open until the buffer is replayed)
+             * \param text The text to display (copied into the buffer)
+             * \param x x-position of the top-left corner of the text (px)
+             * \param y y-position of the top-left corner of the text (px)
+             * \param wrap_width The maximum width for the text to render (px) (a width of zero prevents any wrapping)
+             * \param color The color to draw the text with as an SDL_Color
+             */
+            void render_text(TTF_Font *font, const char16_t *text, const int &x, const int &y, const Uint32 &wrap_width = 0, const SDL_Color &color = {255, 255, 255, 255}) {
+                const std::size_t text_start = this->store_text(text);
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::TTF_TEXT);
+                output.ttf_font = font;
+                output.text_start = text_start;
+                output.shape = {x, y, static_cast<int>(wrap_width), 0};
+                output.color = color;
+            }
+            /** Record rendering text using a bengine::font's glyph atlas (see bengine::render_window::render_text)
+             * \param font The bengine::font to use (has to stay alive until the buffer is replayed; glyphs are laid out at replay time since that needs the renderer)
+             * \param text The text to display (copied into the buffer)
+             * \param x x-position of the top-left corner of the text (px)
+             * \param y y-position of the top-left corner of the text (px)
+             * \param wrap_width The width to wrap the text to (px) (0 for no wrapping)
+             * \param color The color to draw the text with as an SDL_Color
+             */
+            void render_text(bengine::font &font, const char16_t *text, const int &x, const int &y, const int &wrap_width = 0, const SDL_Color &color = {255, 255, 255, 255}) {
+                const std::size_t text_start = this->store_text(text);
+                bengine::command_buffer::command &output = this->record(bengine::command_buffer::command_kind::FONT_TEXT);
+                output.font = &font;
+                output.text_start = text_start;
+                output.shape = {x, y, wrap_width, 0};
+                output.color = color;
+            }
+
+            /** Record pushing a pooled render target (see bengine::render_window::push_render_target); everything after it (on any layer) draws into the target until the matching pop, so a pushed target should be popped on the same layer
+             * \param id The handle returned by bengine::render_window::acquire_render_target
+             */
+            void push_render_target(const unsigned int &id) {
+                this->record(bengine::command_buffer::command_kind::PUSH_TARGET).target = id;
+            }
+            // \brief Record popping the most recently pushed render target (see bengine::render_window::pop_render_target)
+            void pop_render_target() {
+                this->record(bengine::command_buffer::command_kind::POP_TARGET);
+            }
+
+            // \brief Forget every recorded command (the memory is kept for the next frame)
+            void clear() {
+                this->commands.clear();
+                this->text.clear();
+            }
+            /** Get the recorded commands
+             * \returns The recorded commands in the order they were recorded
+             */
+            const std::vector<bengine::command_buffer::command>& get_commands() const {
+                return this->commands;
+            }
+            /** Get the text of a text command
+             * \param command A text command from this buffer
+             * \returns The command's text (null-terminated)
+             */
+            const char16_t* get_text(const bengine::command_buffer::command &command) const {
+                return this->text.c_str() + command.text_start;
+            }
+            /** Get how many commands have been recorded
+             * \returns How many commands have been recorded
+             */
+            std::size_t get_size() const {
+                return this->commands.size();
+            }
+            /** Check whether no commands have been recorded
+             * \returns Whether no commands have been recorded
+             */
+            bool is_empty() const {
+                return this->commands.empty();
+            }
+    };
+}
+
+#endif // BENGINE_COMMAND_BUFFER_hpp
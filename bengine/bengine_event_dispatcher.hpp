@@ -0,0 +1,139 @@
+#ifndef BENGINE_EVENT_DISPATCHER_hpp
+#define BENGINE_EVENT_DISPATCHER_hpp
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <vector>
+
+namespace bengine {
+    /** A table of event handlers keyed by SDL event type, and by scancode or mouse button for keyboard and mouse button events
+     *
+     * Every lookup is a couple of array indexes rather than a search: event types are split into their high byte (SDL's event category) and low byte, and keyboard/mouse button handlers sit in arrays indexed by scancode/button
+     */
+    class event_dispatcher {
+        public:
+            // \brief A function that handles an event
+            typedef std::function<void(const SDL_Event&)> handler;
+
+        private:
+            // \brief The handlers for one table slot
+            typedef std::vector<bengine::event_dispatcher::handler> handler_list;
+
+            // \brief Handlers keyed by event type; indexed by the type's high byte and then by its low byte (the inner tables only grow as large as they need to)
+            std::vector<bengine::event_dispatcher::handler_list> type_handlers[256];
+            // \brief Key press handlers indexed by scancode (empty until a key press handler is added)
+            std::vector<bengine::event_dispatcher::handler_list> key_down_handlers;
+            // \brief Key release handlers indexed by scancode (empty until a key release handler is added)
+            std::vector<bengine::event_dispatcher::handler_list> key_up_handlers;
+            // \brief Mouse button press handlers indexed by button (empty until a button press handler is added)
+            std::vector<bengine::event_dispatcher::handler_list> button_down_handlers;
+            // \brief Mouse button release handlers indexed by button (empty until a button release handler is added)
+            std::vector<bengine::event_dispatcher::handler_list> button_up_handlers;
+
+            /** Get a table slot, growing the table to fit it if needed
+             * \param table The table to get the slot from
+             * \param index The index of the slot
+             * \param size The size to grow the table to if it's too small
+             * \returns The table slot
+             */
+            static bengine::event_dispatcher::handler_list& get_slot(std::vector<bengine::event_dispatcher::handler_list> &table, const std::size_t &index, const std::size_t &size) {
+                if (table.size() <= index) {
+                    table.resize(size > index ? size : index + 1);
+                }
+                return table[index];
+            }
+            /** Call every handler in a table slot, if the slot exists
+             * \param table The table to look in
+             * \param index The index of the slot
+             * \param event The event to pass to the handlers
+             * \returns Whether any handlers were called
+             */
+            static bool call_slot(const std::vector<bengine::event_dispatcher::handler_list> &table, const std::size_t &index, const SDL_Event &event) {
+                if (index >= table.size() || table[index].empty()) {
+                    return false;
+                }
+                const bengine::event_dispatcher::handler_list &handlers = table[index];
+                for (std::size_t i = 0; i < handlers.size(); i++) {
+                    handlers[i](event);
+                }
+                return true;
+            }
+
+        public:
+            // \brief bengine::event_dispatcher constructor
+            event_dispatcher() {}
+            // \brief bengine::event_dispatcher deconstructor
+            ~event_dispatcher() {}
+
+            /** Add a handler for every event of a certain type (handlers shouldn't be added from within a handler)
+             * \param type The event type (an SDL_EventType or a type from SDL_RegisterEvents)
+             * \param handler The function to call
+             */
+            void on_event(const Uint32 &type, const bengine::event_dispatcher::handler &handler) {
+                bengine::event_dispatcher::get_slot(this->type_handlers[(type >> 8) & 0xFF], type & 0xFF, (type & 0xFF) + 1).emplace_back(handler);
+            }
+            /** Add a handler for a key being pressed (including repeats; check event.key.repeat to tell them apart)
+             * \param scancode The key to handle
+             * \param handler The function to call
+             */
+            void on_key_down(const SDL_Scancode &scancode, const bengine::event_dispatcher::handler &handler) {
+                bengine::event_dispatcher::get_slot(this->key_down_handlers, scancode, SDL_NUM_SCANCODES).emplace_back(handler);
+            }
+            /** Add a handler for a key being released
+             * \param scancode The key to handle
+             * \param handler The function to call
+             */
+            void on_key_up(const SDL_Scancode &scancode, const bengine::event_dispatcher::handler &handler) {
+                bengine::event_dispatcher::get_slot(this->key_up_handlers, scancode, SDL_NUM_SCANCODES).emplace_back(handler);
+            }
+            /** Add a handler for a mouse button being pressed
+             * \param button The button to handle (SDL_BUTTON_LEFT, SDL_BUTTON_RIGHT, etc)
+             * \param handler The function to call
+             */
+            void on_button_down(const Uint8 &button, const bengine::event_dispatcher::handler &handler) {
+                bengine::event_dispatcher::get_slot(this->button_down_handlers, button, 8).emplace_back(handler);
+            }
+            /** Add a handler for a mouse button being released
+             * \param button The button to handle (SDL_BUTTON_LEFT, SDL_BUTTON_RIGHT, etc)
+             * \param handler The function to call
+             */
+            void on_button_up(const Uint8 &button, const bengine::event_dispatcher::handler &handler) {
+                bengine::event_dispatcher::get_slot(this->button_up_handlers, button, 8).emplace_back(handler);
+            }
+            // \brief Remove every handler
+            void clear() {
+                for (std::size_t i = 0; i < 256; i++) {
+                    this->type_handlers[i].clear();
+                }
+                this->key_down_handlers.clear();
+                this->key_up_handlers.clear();
+                this->button_down_handlers.clear();
+                this->button_up_handlers.clear();
+            }
+
+            /** Call every handler that matches an event; type handlers are called first and then key/button handlers
+             * \param event The event to dispatch
+             * \returns Whether any handlers were called
+             */
+            bool dispatch(const SDL_Event &event) const {
+                bool handled = bengine::event_dispatcher::call_slot(this->type_handlers[(event.type >> 8) & 0xFF], event.type & 0xFF, event);
+                switch (event.type) {
+                    case SDL_KEYDOWN:
+                        handled |= bengine::event_dispatcher::call_slot(this->key_down_handlers, event.key.keysym.scancode, event);
+                        break;
+                    case SDL_KEYUP:
+                        handled |= bengine::event_dispatcher::call_slot(this->key_up_handlers, event.key.keysym.scancode, event);
+                        break;
+                    case SDL_MOUSEBUTTONDOWN:
+                        handled |= bengine::event_dispatcher::call_slot(this->button_down_handlers, event.button.button, event);
+                        break;
+                    case SDL_MOUSEBUTTONUP:
+                        handled |= bengine::event_dispatcher::call_slot(this->button_up_handlers, event.button.button, event);
+                        break;
+                }
+                return handled;
+            }
+    };
+}
+
+#endif // BENGINE_EVENT_DISPATCHER_hpp
@@ -0,0 +1,401 @@
+#ifndef BENGINE_FONT_hpp
+#define BENGINE_FONT_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bengine {
+    /** A TTF_Font whose glyphs are rasterized once into atlas textures, so that drawing text is a matter of laying out quads rather than rendering and uploading a new surface every call (see bengine::render_window::render_text and bengine::render_window::batch_text)
+     *
+     * Printable ASCII is rasterized the first time the font is drawn with and every other glyph is added the first time it shows up; glyphs are white in the atlas and get their color from the vertices that draw them
+     *
+     * The atlas textures belong to the renderer of the first bengine::render_window that draws with the font, and need to be destroyed before that window is (declaring the font after the window, or as a member of a class derived from bengine::loop, takes care of that)
+     */
+    class font {
+        public:
+            // \brief A glyph placed by bengine::font::layout
+            struct placed_glyph {
+                // \brief The atlas page that the glyph is on
+                std::size_t page;
+                // \brief Where the glyph is on its atlas page (px)
+                SDL_Rect frame;
+                // \brief Where the glyph goes relative to the top-left corner of the text (px)
+                SDL_Rect dst;
+            };
+
+        private:
+            // \brief A glyph's place in the atlas and its metrics
+            struct glyph {
+                // \brief Whether the glyph has been rasterized yet
+                bool loaded = false;
+                // \brief The atlas page that the glyph is on
+                std::size_t page = 0;
+                // \brief Where the glyph is on its atlas page (px) (empty for glyphs with nothing to draw, like spaces)
+                SDL_Rect frame = {0, 0, 0, 0};
+                // \brief How far the pen moves after the glyph (px)
+                int advance = 0;
+            };
+            // \brief A laid out string, kept so that text that gets drawn every frame is only laid out once
+            struct cached_layout {
+                // \brief The text that was laid out
+                std::u16string text;
+                // \brief The width that the text was wrapped to (px) (0 for no wrapping)
+                int wrap_width = -1;
+                // \brief The laid out glyphs
+                std::vector<bengine::font::placed_glyph> glyphs;
+                // \brief The width of the laid out text (px)
+                int width = 0;
+                // \brief The height of the laid out text (px)
+                int height = 0;
+                // \brief When the layout was last used (compared with bengine::font::layout_clock)
+                unsigned long long last_use = 0;
+            };
+
+            // \brief The size of each atlas page's sides (px), unless a glyph is too big to fit on one
+            static const int default_page_size = 512;
+            // \brief How many laid out strings are kept around
+            static const std::size_t layout_cache_size = 8;
+
+            // \brief The font that the glyphs come from
+            TTF_Font *ttf_font = NULL;
+            // \brief Whether the font was opened by this class (and should be closed by it)
+            bool owns_font = false;
+            // \brief The renderer that the atlas pages belong to
+            SDL_Renderer *renderer = NULL;
+
+            // \brief The atlas pages
+            std::vector<SDL_Texture*> pages;
+            // \brief The size of each atlas page's sides (px)
+            int page_size = bengine::font::default_page_size;
+            // \brief Where the next glyph goes on the newest page, along the x-axis (px)
+            int shelf_x = 0;
+            // \brief The top of the row ("shelf") of glyphs being filled on the newest page (px)
+            int shelf_y = 0;
+            // \brief The height of the tallest glyph on the shelf being filled (px)
+            int shelf_height = 0;
+
+            // \brief Glyphs for the first 128 code points, looked up directly
+            bengine::font::glyph ascii_glyphs[128];
+            // \brief Glyphs for every other code point
+            std::unordered_map<char16_t, bengine::font::glyph> other_glyphs;
+            // \brief Kerning between pairs of code points keyed by (previous << 16 | current) (px)
+            std::unordered_map<Uint32, int> kerning;
+
+            // \brief Recently laid out strings
+            bengine::font::cached_layout layouts[bengine::font::layout_cache_size];
+            // \brief Counts calls to bengine::font::layout to find the least recently used layout
+            unsigned long long layout_clock = 0;
+
+            /** Create a new, empty atlas page and start filling it
+             * \returns Whether the page was created
+             */
+            bool add_page() {
+                SDL_Texture *page = SDL_CreateTexture(this->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, this->page_size, this->page_size);
+                if (page == NULL) {
+                    std::cout << "Failed to create a glyph atlas page [bengine::font::add_page]\nSDL Error: " << SDL_GetError() << "\n";
+                    return false;
+                }
+                // Static textures start out with whatever was in memory, so the page gets cleared to transparent once up front
+                const std::vector<Uint32> blank(static_cast<std::size_t>(this->page_size) * this->page_size, 0);
+                SDL_UpdateTexture(page, NULL, blank.data(), this->page_size * static_cast<int>(sizeof(Uint32)));
+                SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+
+                this->pages.emplace_back(page);
+                this->shelf_x = 0;
+                this->shelf_y = 0;
+                this->shelf_height = 0;
+                return true;
+            }
+            /** Rasterize a glyph and copy it into the atlas
+             * \param code_point The glyph to rasterize
+             * \param output Where to store the glyph's place in the atlas and its metrics
+             */
+            void load_glyph(const char16_t &code_point, bengine::font::glyph &output) {
+                output.loaded = true;
+                int min_x = 0, max_x = 0, min_y = 0, max_y = 0;
+                if (TTF_GlyphMetrics(this->ttf_font, code_point, &min_x, &max_x, &min_y, &max_y, &output.advance) != 0) {
+                    output.advance = 0;
+                }
+
+                SDL_Surface *surface = TTF_RenderGlyph_Blended(this->ttf_font, code_point, {255, 255, 255, 255});
+                if (surface == NULL) {
+                    return;
+                }
+                if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+                    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+                    SDL_FreeSurface(surface);
+                    if ((surface = converted) == NULL) {
+                        return;
+                    }
+                }
+                if (surface->w <= 0 || surface->h <= 0) {
+                    SDL_FreeSurface(surface);
+                    return;
+                }
+
+                // Glyphs are packed onto shelves (rows as tall as their tallest glyph), with a pixel of space between them so that filtering never bleeds neighbours in
+                if (surface->w + 1 > this->page_size || surface->h + 1 > this->page_size) {
+                    std::cout << "Glyph " << static_cast<unsigned int>(code_point) << " is too big for the glyph atlas [bengine::font::load_glyph]\n";
+                    SDL_FreeSurface(surface);
+                    return;
+                }
+                if (this->shelf_x + surface->w + 1 > this->page_size) {
+                    this->shelf_x = 0;
+                    this->shelf_y += this->shelf_height + 1;
+                    this->shelf_height = 0;
+                }
+                if (this->pages.empty() || this->shelf_y + surface->h + 1 > this->page_size) {
+                    if (!this->add_page()) {
+                        SDL_FreeSurface(surface);
+                        return;
+                    }
+                }
+
+                output.page = this->pages.size() - 1;
+                output.frame = {this->shelf_x, this->shelf_y, surface->w, surface->h};
+                if (SDL_UpdateTexture(this->pages.back(), &output.frame, surface->pixels, surface->pitch) != 0) {
+                    std::cout << "Failed to copy glyph " << static_cast<unsigned int>(code_point) << " into the glyph atlas [bengine::font::load_glyph]\nSDL Error: " << SDL_GetError() << "\n";
+                    output.frame = {0, 0, 0, 0};
+                }
+                this->shelf_x += surface->w + 1;
+                this->shelf_height = std::max(this->shelf_height, surface->h);
+                SDL_FreeSurface(surface);
+            }
+            /** Get a glyph, rasterizing it if this is the first time it's been asked for
+             * \param code_point The glyph to get
+             * \returns The glyph's place in the atlas and its metrics
+             */
+            const bengine::font::glyph& get_glyph(const char16_t &code_point) {
+                bengine::font::glyph &output = code_point < 128 ? this->ascii_glyphs[code_point] : this->other_glyphs[code_point];
+                if (!output.loaded) {
+                    this->load_glyph(code_point, output);
+                }
+                return output;
+            }
+            /** Get the kerning between two glyphs, asking SDL_ttf only the first time that pair comes up
+             * \param previous The glyph before
+             * \param current The glyph after
+             * \returns How far to move the current glyph along the x-axis (px)
+             */
+            int get_kerning(const char16_t &previous, const char16_t &current) {
+                const Uint32 key = (static_cast<Uint32>(previous) << 16) | current;
+                const auto cached = this->kerning.find(key);
+                if (cached != this->kerning.end()) {
+                    return cached->second;
+                }
+                int output = TTF_GetFontKerningSizeGlyphs(this->ttf_font, previous, current);
+                if (output < 0) {
+                    output = 0;
+                }
+                this->kerning.emplace(key, output);
+                return output;
+            }
+            /** Destroy every atlas page and forget every glyph, which get rasterized again the next time they're needed
+             */
+            void clear_atlas() {
+                for (std::size_t i = 0; i < this->pages.size(); i++) {
+                    SDL_DestroyTexture(this->pages[i]);
+                }
+                this->pages.clear();
+                this->shelf_x = 0;
+                this->shelf_y = 0;
+                this->shelf_height = 0;
+                for (std::size_t i = 0; i < 128; i++) {
+                    this->ascii_glyphs[i] = bengine::font::glyph();
+                }
+                this->other_glyphs.clear();
+                for (std::size_t i = 0; i < bengine::font::layout_cache_size; i++) {
+                    this->layouts[i].wrap_width = -1;
+                    this->layouts[i].text.clear();
+                }
+            }
+            /** Lay a string out into a cached layout; lines break at newlines and, when wrapping, at the last space that fits (or mid-word if a word is too long for a line by itself)
+             * \param text The text to lay out
+             * \param wrap_width The width to wrap the text to (px) (0 for no wrapping)
+             * \param output Where to store the layout
+             */
+            void build_layout(const char16_t *text, const int &wrap_width, bengine::font::cached_layout &output) {
+                output.text.assign(text);
+                output.wrap_width = wrap_width;
+                output.glyphs.clear();
+                output.width = 0;
+
+                const int line_skip = TTF_FontLineSkip(this->ttf_font);
+                const int height = TTF_FontHeight(this->ttf_font);
+                int pen_x = 0;
+                int pen_y = 0;
+                char16_t previous = 0;
+                // Where the line can be broken: the first glyph after the most recent space and the pen position at that glyph
+                std::size_t break_glyph = 0;
+                int break_x = -1;
+
+                for (std::size_t i = 0; i < output.text.size(); i++) {
+                    const char16_t code_point = output.text[i];
+                    if (code_point == u'\n') {
+                        output.width = std::max(output.width, pen_x);
+                        pen_x = 0;
+                        pen_y += line_skip;
+                        previous = 0;
+                        break_x = -1;
+                        continue;
+                    }
+                    // Characters outside the basic multilingual plane can't be drawn by SDL_ttf's 16-bit glyph functions
+                    if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+                        continue;
+                    }
+
+                    const bengine::font::glyph &current = this->get_glyph(code_point);
+                    if (previous != 0) {
+                        pen_x += this->get_kerning(previous, code_point);
+                    }
+                    previous = code_point;
+
+                    if (wrap_width > 0 && code_point != u' ' && pen_x + current.advance > wrap_width && pen_x > 0) {
+                        // Move everything since the last break onto a new line, or break right here if there's nowhere better
+                        const int shift = break_x > 0 ? break_x : pen_x;
+                        const std::size_t first_moved = break_x > 0 ? break_glyph : output.glyphs.size();
+                        output.width = std::max(output.width, shift);
+                        pen_y += line_skip;
+                        for (std::size_t j = first_moved; j < output.glyphs.size(); j++) {
+                            output.glyphs[j].dst.x -= shift;
+                            output.glyphs[j].dst.y += line_skip;
+                        }
+                        pen_x -= shift;
+                        break_x = -1;
+                    }
+
+                    if (current.frame.w > 0) {
+                        output.glyphs.push_back({current.page, current.frame, {pen_x, pen_y, current.frame.w, current.frame.h}});
+                    }
+                    pen_x += current.advance;
+                    if (code_point == u' ') {
+                        break_glyph = output.glyphs.size();
+                        break_x = pen_x;
+                    }
+                }
+                output.width = std::max(output.width, pen_x);
+                output.height = pen_y + height;
+            }
+
+        public:
+            /** bengine::font constructor; uses a TTF_Font that stays owned by the caller
+             * \param ttf_font The TTF_Font to rasterize glyphs from (represents both the font and size of the font); has to outlive this object
+             */
+            explicit font(TTF_Font *ttf_font) : ttf_font(ttf_font) {}
+            /** bengine::font constructor; opens its own TTF_Font and closes it when destroyed (SDL_ttf needs to be initialized already)
+             * \param filepath The path to the font file
+             * \param size The size of the font (pt)
+             */
+            font(const char *filepath, const int &size) : owns_font(true) {
+                if ((this->ttf_font = TTF_OpenFont(filepath, size)) == NULL) {
+                    std::cout << "Failed to open font \"" << filepath << "\" [bengine::font::font]\nTTF Error: " << TTF_GetError() << "\n";
+                }
+            }
+            font(const bengine::font&) = delete;
+            bengine::font& operator=(const bengine::font&) = delete;
+            // \brief bengine::font deconstructor
+            ~font() {
+                this->clear_atlas();
+                if (this->owns_font && this->ttf_font != NULL) {
+                    TTF_CloseFont(this->ttf_font);
+                }
+            }
+
+            /** Get the TTF_Font that the glyphs come from
+             * \returns The TTF_Font that the glyphs come from
+             */
+            TTF_Font* get_ttf_font() const {
+                return this->ttf_font;
+            }
+            /** Get how far apart lines of text are
+             * \returns How far apart lines of text are (px)
+             */
+            int get_line_skip() const {
+                return this->ttf_font == NULL ? 0 : TTF_FontLineSkip(this->ttf_font);
+            }
+            /** Get an atlas page
+             * \param index The index of the page
+             * \returns The atlas page (NULL if there isn't one at that index)
+             */
+            SDL_Texture* get_page(const std::size_t &index) const {
+                return index < this->pages.size() ? this->pages[index] : NULL;
+            }
+            /** Get the size of each atlas page's sides
+             * \returns The size of each atlas page's sides (px)
+             */
+            int get_page_size() const {
+                return this->page_size;
+            }
+            /** Get how many atlas pages there are
+             * \returns How many atlas pages there are
+             */
+            std::size_t get_page_count() const {
+                return this->pages.size();
+            }
+
+            /** Lay out a string, reusing the layout from a recent call with the same text and wrap width if there is one
+             * \param renderer The renderer that the text is going to be drawn with (the atlas is rebuilt if this changes)
+             * \param text The text to lay out (literals are written as u"[text]", std::u16string is useful too)
+             * \param wrap_width The width to wrap the text to (px) (0 for no wrapping)
+             * \param width Where to store the width of the laid out text (px) (can be NULL)
+             * \param height Where to store the height of the laid out text (px) (can be NULL)
+             * \returns The laid out glyphs; only valid until the next call
+             */
+            const std::vector<bengine::font::placed_glyph>& layout(SDL_Renderer *renderer, const char16_t *text, const int &wrap_width = 0, int *width = NULL, int *height = NULL) {
+                static const std::vector<bengine::font::placed_glyph> empty;
+                if (this->ttf_font == NULL || text == NULL) {
+                    if (width != NULL) {
+                        *width = 0;
+                    }
+                    if (height != NULL) {
+                        *height = 0;
+                    }
+                    return empty;
+                }
+                if (renderer != this->renderer) {
+                    this->clear_atlas();
+                    this->renderer = renderer;
+                    const int glyph_size = TTF_FontHeight(this->ttf_font) * 2 + 2;
+                    this->page_size = bengine::font::default_page_size;
+                    while (this->page_size < glyph_size * 4) {
+                        this->page_size *= 2;
+                    }
+                    for (char16_t code_point = u' '; code_point < 127; code_point++) {
+                        this->get_glyph(code_point);
+                    }
+                }
+
+                this->layout_clock++;
+                bengine::font::cached_layout *output = &this->layouts[0];
+                for (std::size_t i = 0; i < bengine::font::layout_cache_size; i++) {
+                    bengine::font::cached_layout &candidate = this->layouts[i];
+                    if (candidate.wrap_width == wrap_width && candidate.text.compare(text) == 0) {
+                        output = &candidate;
+                        break;
+                    }
+                    if (candidate.last_use < output->last_use) {
+                        output = &candidate;
+                    }
+                }
+                if (output->wrap_width != wrap_width || output->text.compare(text) != 0) {
+                    this->build_layout(text, wrap_width, *output);
+                }
+                output->last_use = this->layout_clock;
+
+                if (width != NULL) {
+                    *width = output->width;
+                }
+                if (height != NULL) {
+                    *height = output->height;
+                }
+                return output->glyphs;
+            }
+    };
+}
+
+#endif // BENGINE_FONT_hpp
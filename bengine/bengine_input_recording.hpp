@@ -0,0 +1,417 @@
+#ifndef BENGINE_INPUT_RECORDING_hpp
+#define BENGINE_INPUT_RECORDING_hpp
+
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace bengine {
+    /** A compact log of every event plus the keyboard and mouse state for each computation step, used by bengine::loop to record a session and replay it exactly
+     *
+     * Ticks are stored back-to-back, so a tick's number is its position in the log; each one starts with a byte of flags saying what changed since the tick before it, which means a tick where nothing happened costs a single byte
+     *
+     * Events that carry pointers (file drops, system window manager messages, and user events) can't be written out, so they're left out of the log
+     */
+    class input_recording {
+        private:
+            // \brief The bytes that every recording file starts with
+            static const Uint32 magic = 0x504E4942;
+            // \brief The version of the file format; files with a different version are refused
+            static const Uint8 version = 1;
+
+            // \brief Tick flag marking that some keys were pressed or released
+            static const Uint8 keys_changed = 1;
+            // \brief Tick flag marking that the mouse moved or its buttons changed
+            static const Uint8 mouse_changed = 2;
+            // \brief Tick flag marking that there are events for the tick
+            static const Uint8 has_events = 4;
+            // \brief Tick flag marking that delta_time changed
+            static const Uint8 delta_time_changed = 8;
+
+            // \brief The encoded ticks
+            std::vector<Uint8> data;
+            // \brief How many ticks are in the log
+            unsigned long long tick_count = 0;
+
+            // \brief The keyboard state as of the most recently recorded/replayed tick
+            Uint8 keys[SDL_NUM_SCANCODES] = {};
+            // \brief The mouse's x-position as of the most recently recorded/replayed tick (px)
+            int mouse_x = 0;
+            // \brief The mouse's y-position as of the most recently recorded/replayed tick (px)
+            int mouse_y = 0;
+            // \brief The mouse button bitmask (as returned by SDL_GetMouseState) as of the most recently recorded/replayed tick
+            Uint32 mouse_buttons = 0;
+            // \brief The delta_time as of the most recently recorded/replayed tick (seconds); 0 until the first tick
+            double delta_time = 0.0;
+
+            // \brief Events that have been recorded since the last tick was finished
+            std::vector<SDL_Event> pending_events;
+
+            // \brief Where in bengine::input_recording::data the next tick to replay starts
+            std::size_t read_position = 0;
+            // \brief How many ticks have been replayed since the last rewind
+            unsigned long long ticks_replayed = 0;
+
+            /** Append an unsigned integer to the log using as few bytes as possible (7 bits per byte)
+             * \param value The value to append
+             */
+            void write_varint(Uint64 value) {
+                while (value >= 0x80) {
+                    this->data.emplace_back(static_cast<Uint8>(value | 0x80));
+                    value >>= 7;
+                }
+                this->data.emplace_back(static_cast<Uint8>(value));
+            }
+            /** Append a signed integer to the log using as few bytes as possible (small negative values stay small)
+             * \param value The value to append
+             */
+            void write_signed_varint(const Sint64 &value) {
+                this->write_varint((static_cast<Uint64>(value) << 1) ^ static_cast<Uint64>(value >> 63));
+            }
+            /** Read an unsigned integer written by bengine::input_recording::write_varint
+             * \returns The value that was read (0 if the log ends partway through)
+             */
+            Uint64 read_varint() {
+                Uint64 output = 0;
+                for (unsigned char shift = 0; this->read_position < this->data.size() && shift < 64; shift += 7) {
+                    const Uint8 byte = this->data[this->read_position++];
+                    output |= static_cast<Uint64>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0) {
+                        break;
+                    }
+                }
+                return output;
+            }
+            /** Read a signed integer written by bengine::input_recording::write_signed_varint
+             * \returns The value that was read
+             */
+            Sint64 read_signed_varint() {
+                const Uint64 value = this->read_varint();
+                return static_cast<Sint64>(value >> 1) ^ -static_cast<Sint64>(value & 1);
+            }
+
+            /** Append a double to the log as 8 little-endian bytes
+             * \param value The value to append
+             */
+            void write_double(const double &value) {
+                Uint64 bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+                for (unsigned char i = 0; i < 8; i++) {
+                    this->data.emplace_back(static_cast<Uint8>(bits >> (i * 8)));
+                }
+            }
+            /** Read a double written by bengine::input_recording::write_double
+             * \returns The value that was read (0 if the log ends partway through)
+             */
+            double read_double() {
+                if (this->read_position + 8 > this->data.size()) {
+                    this->read_position = this->data.size();
+                    return 0.0;
+                }
+                Uint64 bits = 0;
+                for (unsigned char i = 0; i < 8; i++) {
+                    bits |= static_cast<Uint64>(this->data[this->read_position++]) << (i * 8);
+                }
+                double output = 0.0;
+                std::memcpy(&output, &bits, sizeof(output));
+                return output;
+            }
+
+            /** Check whether an event can be written to the log (events holding pointers can't be)
+             * \param event The event to check
+             * \returns Whether the event can be written to the log
+             */
+            static bool is_recordable(const SDL_Event &event) {
+                switch (event.type) {
+                    case SDL_DROPFILE:
+                    case SDL_DROPTEXT:
+                    case SDL_SYSWMEVENT:
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+                    case SDL_TEXTEDITING_EXT:
+#endif
+                        return false;
+                }
+                return event.type < SDL_USEREVENT;
+            }
+
+            // \brief Print the output of SDL_GetError with a timestamp and some extra formatting
+            void print_error() const {
+                std::cout << "\nERROR [" << SDL_GetTicks() << "]: " << SDL_GetError() << "\n";
+            }
+
+        public:
+            // \brief bengine::input_recording constructor
+            input_recording() {}
+            // \brief bengine::input_recording deconstructor
+            ~input_recording() {}
+
+            // \brief Throw away every recorded tick and go back to a blank input state
+            void clear() {
+                this->data.clear();
+                this->tick_count = 0;
+                this->pending_events.clear();
+                std::memset(this->keys, 0, SDL_NUM_SCANCODES);
+                this->mouse_x = this->mouse_y = 0;
+                this->mouse_buttons = 0;
+                this->delta_time = 0.0;
+                this->read_position = 0;
+                this->ticks_replayed = 0;
+            }
+
+            /** Add an event to the tick that is currently being recorded
+             * \param event The event to add (ignored if it holds pointers)
+             */
+            void record_event(const SDL_Event &event) {
+                if (bengine::input_recording::is_recordable(event)) {
+                    this->pending_events.emplace_back(event);
+                }
+            }
+            /** Finish recording a tick; only what changed since the previous tick gets written
+             * \param keystate The keyboard state for the tick (SDL_NUM_SCANCODES entries)
+             * \param mouse_x The mouse's x-position for the tick (px)
+             * \param mouse_y The mouse's y-position for the tick (px)
+             * \param mouse_buttons The mouse button bitmask for the tick
+             * \param delta_time The delta_time that the tick will be computed with (seconds)
+             */
+            void record_tick(const Uint8 *keystate, const int &mouse_x, const int &mouse_y, const Uint32 &mouse_buttons, const double &delta_time) {
+                std::vector<Uint16> changed_keys;
+                for (Uint16 i = 0; i < SDL_NUM_SCANCODES; i++) {
+                    if ((keystate[i] != 0) != (this->keys[i] != 0)) {
+                        changed_keys.emplace_back(i);
+                        this->keys[i] = keystate[i] != 0;
+                    }
+                }
+                const bool mouse_moved = mouse_x != this->mouse_x || mouse_y != this->mouse_y || mouse_buttons != this->mouse_buttons;
+
+                Uint8 flags = 0;
+                flags |= changed_keys.empty() ? 0 : bengine::input_recording::keys_changed;
+                flags |= mouse_moved ? bengine::input_recording::mouse_changed : 0;
+                flags |= this->pending_events.empty() ? 0 : bengine::input_recording::has_events;
+                flags |= delta_time != this->delta_time ? bengine::input_recording::delta_time_changed : 0;
+                this->data.emplace_back(flags);
+
+                if (!changed_keys.empty()) {
+                    this->write_varint(changed_keys.size());
+                    for (std::size_t i = 0; i < changed_keys.size(); i++) {
+                        this->write_varint(changed_keys[i]);
+                    }
+                }
+                if (mouse_moved) {
+                    this->write_signed_varint(mouse_x);
+                    this->write_signed_varint(mouse_y);
+                    this->write_varint(mouse_buttons);
+                    this->mouse_x = mouse_x;
+                    this->mouse_y = mouse_y;
+                    this->mouse_buttons = mouse_buttons;
+                }
+                if (!this->pending_events.empty()) {
+                    this->write_varint(this->pending_events.size());
+                    const Uint8 *bytes = reinterpret_cast<const Uint8*>(this->pending_events.data());
+                    this->data.insert(this->data.end(), bytes, bytes + this->pending_events.size() * sizeof(SDL_Event));
+                    this->pending_events.clear();
+                }
+                if (delta_time != this->delta_time) {
+                    this->write_double(delta_time);
+                    this->delta_time = delta_time;
+                }
+
+                this->tick_count++;
+            }
+
+            // \brief Go back to the first tick so that the log can be replayed from the start
+            void rewind() {
+                std::memset(this->keys, 0, SDL_NUM_SCANCODES);
+                this->mouse_x = this->mouse_y = 0;
+                this->mouse_buttons = 0;
+                this->delta_time = 0.0;
+                this->read_position = 0;
+                this->ticks_replayed = 0;
+            }
+            /** Get whether every tick in the log has been replayed
+             * \returns Whether every tick in the log has been replayed
+             */
+            bool is_finished() const {
+                return this->ticks_replayed >= this->tick_count || this->read_position >= this->data.size();
+            }
+            /** Decode the next tick, updating the keyboard/mouse state and delta_time that the getters return
+             * \param events Filled with the tick's events (cleared first)
+             * \returns Whether there was a tick left to replay
+             */
+            bool replay_tick(std::vector<SDL_Event> &events) {
+                events.clear();
+                if (this->is_finished()) {
+                    return false;
+                }
+
+                const Uint8 flags = this->data[this->read_position++];
+                if ((flags & bengine::input_recording::keys_changed) != 0) {
+                    const Uint64 count = this->read_varint();
+                    for (Uint64 i = 0; i < count; i++) {
+                        const Uint64 scancode = this->read_varint();
+                        if (scancode < SDL_NUM_SCANCODES) {
+                            this->keys[scancode] = !this->keys[scancode];
+                        }
+                    }
+                }
+                if ((flags & bengine::input_recording::mouse_changed) != 0) {
+                    this->mouse_x = static_cast<int>(this->read_signed_varint());
+                    this->mouse_y = static_cast<int>(this->read_signed_varint());
+                    this->mouse_buttons = static_cast<Uint32>(this->read_varint());
+                }
+                if ((flags & bengine::input_recording::has_events) != 0) {
+                    const Uint64 count = this->read_varint();
+                    if (this->read_position + count * sizeof(SDL_Event) > this->data.size()) {
+                        this->read_position = this->data.size();
+                        return false;
+                    }
+                    events.resize(count);
+                    std::memcpy(events.data(), this->data.data() + this->read_position, count * sizeof(SDL_Event));
+                    this->read_position += count * sizeof(SDL_Event);
+                }
+                if ((flags & bengine::input_recording::delta_time_changed) != 0) {
+                    this->delta_time = this->read_double();
+                }
+
+                this->ticks_replayed++;
+                return true;
+            }
+
+            /** Get the keyboard state as of the most recently recorded/replayed tick
+             * \returns The keyboard state (SDL_NUM_SCANCODES entries, indexed by SDL_Scancode)
+             */
+            const Uint8* get_keystate() const {
+                return this->keys;
+            }
+            /** Get the mouse's x-position as of the most recently recorded/replayed tick
+             * \returns The mouse's x-position (px)
+             */
+            int get_mouse_x() const {
+                return this->mouse_x;
+            }
+            /** Get the mouse's y-position as of the most recently recorded/replayed tick
+             * \returns The mouse's y-position (px)
+             */
+            int get_mouse_y() const {
+                return this->mouse_y;
+            }
+            /** Get the mouse button bitmask as of the most recently recorded/replayed tick
+             * \returns The mouse button bitmask (as returned by SDL_GetMouseState)
+             */
+            Uint32 get_mouse_buttons() const {
+                return this->mouse_buttons;
+            }
+            /** Get the delta_time as of the most recently recorded/replayed tick
+             * \returns The delta_time (seconds)
+             */
+            double get_delta_time() const {
+                return this->delta_time;
+            }
+
+            /** Get how many ticks are in the log
+             * \returns How many ticks are in the log
+             */
+            unsigned long long get_tick_count() const {
+                return this->tick_count;
+            }
+            /** Get how many ticks have been replayed since the last rewind
+             * \returns How many ticks have been replayed since the last rewind
+             */
+            unsigned long long get_ticks_replayed() const {
+                return this->ticks_replayed;
+            }
+            /** Get how large the encoded log is
+             * \returns How large the encoded log is (bytes)
+             */
+            std::size_t get_size() const {
+                return this->data.size();
+            }
+
+            /** Write the log to a file
+             *
+             * Events are stored as raw SDL_Event structures, so a file can only be loaded by a build with the same SDL_Event layout and byte order
+             *
+             * \param path The path of the file to write
+             * \returns 0 on success or a negative error code on failure
+             */
+            int save(const char* path) const {
+                SDL_RWops *file = SDL_RWFromFile(path, "wb");
+                if (file == NULL) {
+                    std::cout << "Input recording failed to open \"" << path << "\" for writing [bengine::input_recording::save]";
+                    this->print_error();
+                    return -1;
+                }
+
+                Uint8 header[16] = {};
+                for (unsigned char i = 0; i < 4; i++) {
+                    header[i] = static_cast<Uint8>(bengine::input_recording::magic >> (i * 8));
+                }
+                header[4] = bengine::input_recording::version;
+                header[5] = static_cast<Uint8>(sizeof(SDL_Event));
+                header[6] = SDL_BYTEORDER == SDL_LIL_ENDIAN ? 0 : 1;
+                for (unsigned char i = 0; i < 8; i++) {
+                    header[8 + i] = static_cast<Uint8>(this->tick_count >> (i * 8));
+                }
+
+                int output = 0;
+                if (SDL_RWwrite(file, header, sizeof(header), 1) != 1 || (!this->data.empty() && SDL_RWwrite(file, this->data.data(), this->data.size(), 1) != 1)) {
+                    std::cout << "Input recording failed to write to \"" << path << "\" [bengine::input_recording::save]";
+                    this->print_error();
+                    output = -2;
+                }
+                SDL_RWclose(file);
+                return output;
+            }
+            /** Replace the log with one read from a file and rewind it
+             * \param path The path of the file to read
+             * \returns 0 on success or a negative error code on failure (the log is left empty on failure)
+             */
+            int load(const char* path) {
+                this->clear();
+
+                SDL_RWops *file = SDL_RWFromFile(path, "rb");
+                if (file == NULL) {
+                    std::cout << "Input recording failed to open \"" << path << "\" for reading [bengine::input_recording::load]";
+                    this->print_error();
+                    return -1;
+                }
+
+                Uint8 header[16] = {};
+                const Sint64 file_size = SDL_RWsize(file);
+                if (file_size < static_cast<Sint64>(sizeof(header)) || SDL_RWread(file, header, sizeof(header), 1) != 1) {
+                    std::cout << "Input recording failed to read the header of \"" << path << "\" [bengine::input_recording::load]\n";
+                    SDL_RWclose(file);
+                    return -2;
+                }
+
+                Uint32 file_magic = 0;
+                for (unsigned char i = 0; i < 4; i++) {
+                    file_magic |= static_cast<Uint32>(header[i]) << (i * 8);
+                }
+                if (file_magic != bengine::input_recording::magic || header[4] != bengine::input_recording::version || header[5] != sizeof(SDL_Event) || header[6] != (SDL_BYTEORDER == SDL_LIL_ENDIAN ? 0 : 1)) {
+                    std::cout << "Input recording \"" << path << "\" is not a recording or was made by an incompatible build [bengine::input_recording::load]\n";
+                    SDL_RWclose(file);
+                    return -3;
+                }
+
+                unsigned long long file_tick_count = 0;
+                for (unsigned char i = 0; i < 8; i++) {
+                    file_tick_count |= static_cast<unsigned long long>(header[8 + i]) << (i * 8);
+                }
+                this->data.resize(static_cast<std::size_t>(file_size) - sizeof(header));
+                if (!this->data.empty() && SDL_RWread(file, this->data.data(), this->data.size(), 1) != 1) {
+                    std::cout << "Input recording failed to read from \"" << path << "\" [bengine::input_recording::load]";
+                    this->print_error();
+                    SDL_RWclose(file);
+                    this->clear();
+                    return -4;
+                }
+                SDL_RWclose(file);
+
+                this->tick_count = file_tick_count;
+                return 0;
+            }
+    };
+}
+
+#endif // BENGINE_INPUT_RECORDING_hpp
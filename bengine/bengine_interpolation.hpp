@@ -0,0 +1,192 @@
+#ifndef BENGINE_INTERPOLATION_hpp
+#define BENGINE_INTERPOLATION_hpp
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "btils_main.hpp"
+#include "bengine_coordinate_2d.hpp"
+
+namespace bengine {
+    // \brief A virtual class that lets bengine::state_interpolator store the previous state of anything it tracks without knowing its type
+    class base_interpolated_state {
+        public:
+            // \brief bengine::base_interpolated_state constructor
+            base_interpolated_state() {}
+            // \brief bengine::base_interpolated_state deconstructor
+            virtual ~base_interpolated_state() {}
+
+            // \brief Copy the live state into the previous state; virtual function
+            virtual void store_previous() = 0;
+    };
+
+    /** A piece of state that keeps a copy of its value from before the most recent computation step so that it can be blended with its live (current) value when rendering
+     * \tparam type An arithmetic type or a bengine::coordinate_2d
+     */
+    template <class type> class interpolated_state : public bengine::base_interpolated_state {
+        private:
+            // \brief The live value that is modified by computation steps (not owned)
+            type *source = nullptr;
+            // \brief A copy of the live value from before the most recent computation step
+            type previous;
+            // \brief The period that the value wraps around at (C_2PI for radian angles, 360 for degree angles, 0 for no wrapping)
+            double period = 0;
+
+        public:
+            /** bengine::interpolated_state constructor
+             * \param source The live value to track (must outlive this object)
+             * \param period The period that the value wraps around at (C_2PI for radian angles, 360 for degree angles, 0 for no wrapping); only used for arithmetic types
+             */
+            interpolated_state(type *source, const double &period = 0) : source(source), previous(*source), period(period) {}
+            // \brief bengine::interpolated_state deconstructor
+            ~interpolated_state() {}
+
+            // \brief Copy the live value into the previous value
+            void store_previous() override {
+                this->previous = *this->source;
+            }
+            // \brief Make the previous value match the live value so that a sudden jump (a teleport, a reset, etc) isn't smeared across a frame
+            void snap() {
+                this->store_previous();
+            }
+
+            /** Get the value from before the most recent computation step
+             * \returns The value from before the most recent computation step
+             */
+            type get_previous() const {
+                return this->previous;
+            }
+            /** Get the live value
+             * \returns The live value
+             */
+            type get_current() const {
+                return *this->source;
+            }
+            /** Get a blend of the previous and live values
+             * \param alpha How far between the previous (0) and live (1) values to blend; usually bengine::loop::interpolation_factor
+             * \returns The blended value
+             */
+            type get_blended(const double &alpha) const {
+                if (this->period != 0) {
+                    return bengine::interpolated_state<type>::blend_periodic(this->previous, *this->source, alpha, this->period);
+                }
+                return bengine::interpolated_state<type>::blend(this->previous, *this->source, alpha);
+            }
+
+            /** Linearly blend two arithmetic values
+             * \param start The value to blend from
+             * \param end The value to blend to
+             * \param alpha How far between the two values to blend (0 = start, 1 = end)
+             * \returns The blended value (rounded for integral types)
+             */
+            template <class arithmetic_type> static arithmetic_type blend(const arithmetic_type &start, const arithmetic_type &end, const double &alpha) {
+                static_assert(std::is_arithmetic<arithmetic_type>::value, "Template type \"arithmetic_type\" must be an arithmetic type (int, long, float, double, etc)");
+                const double output = start + (end - start) * alpha;
+                return std::is_integral<arithmetic_type>::value ? static_cast<arithmetic_type>(std::round(output)) : static_cast<arithmetic_type>(output);
+            }
+            /** Linearly blend two coordinates
+             * \param start The coordinate to blend from
+             * \param end The coordinate to blend to
+             * \param alpha How far between the two coordinates to blend (0 = start, 1 = end)
+             * \returns The blended coordinate
+             */
+            template <class arithmetic_type> static bengine::coordinate_2d<arithmetic_type> blend(const bengine::coordinate_2d<arithmetic_type> &start, const bengine::coordinate_2d<arithmetic_type> &end, const double &alpha) {
+                return bengine::coordinate_2d<arithmetic_type>(bengine::interpolated_state<type>::blend(start.get_x_pos(), end.get_x_pos(), alpha), bengine::interpolated_state<type>::blend(start.get_y_pos(), end.get_y_pos(), alpha));
+            }
+            /** Blend two values that wrap around (like angles) along the shortest path between them
+             * \param start The value to blend from
+             * \param end The value to blend to
+             * \param alpha How far between the two values to blend (0 = start, 1 = end)
+             * \param period The period that the values wrap around at
+             * \returns The blended value normalized to [0, period)
+             */
+            template <class arithmetic_type> static arithmetic_type blend_periodic(const arithmetic_type &start, const arithmetic_type &end, const double &alpha, const double &period) {
+                static_assert(std::is_arithmetic<arithmetic_type>::value, "Template type \"arithmetic_type\" must be an arithmetic type (int, long, float, double, etc)");
+                double difference = btils::normalize_value_to_range<double>(static_cast<double>(end) - start, period);
+                if (difference > period / 2) {
+                    difference -= period;
+                }
+                return static_cast<arithmetic_type>(btils::normalize_value_to_range<double>(start + difference * alpha, period));
+            }
+            /** Coordinates don't wrap around, so this just falls back to a linear blend (the period is ignored)
+             * \param start The coordinate to blend from
+             * \param end The coordinate to blend to
+             * \param alpha How far between the two coordinates to blend (0 = start, 1 = end)
+             * \returns The blended coordinate
+             */
+            template <class arithmetic_type> static bengine::coordinate_2d<arithmetic_type> blend_periodic(const bengine::coordinate_2d<arithmetic_type> &start, const bengine::coordinate_2d<arithmetic_type> &end, const double &alpha, const double &) {
+                return bengine::interpolated_state<type>::blend(start, end, alpha);
+            }
+    };
+
+    // \brief A registry of state that should be rendered somewhere between its previous and current values; bengine::loop stores the previous values before every computation step
+    class state_interpolator {
+        private:
+            // \brief Everything that is being tracked
+            std::vector<std::unique_ptr<bengine::base_interpolated_state>> states;
+
+        public:
+            // \brief bengine::state_interpolator constructor
+            state_interpolator() {}
+            // \brief bengine::state_interpolator deconstructor
+            ~state_interpolator() {}
+
+            /** Start tracking a live value
+             * \tparam type An arithmetic type or a bengine::coordinate_2d
+             * \param source The live value to track (must stay alive until it's untracked or the interpolator is cleared)
+             * \returns A reference to the tracked state that stays valid until it's untracked; it's also the handle that bengine::state_interpolator::untrack takes
+             */
+            template <class type> bengine::interpolated_state<type>& track(type *source) {
+                this->states.emplace_back(new bengine::interpolated_state<type>(source));
+                return *static_cast<bengine::interpolated_state<type>*>(this->states.back().get());
+            }
+            /** Start tracking a live angle so that blending takes the shortest path around the circle
+             * \tparam type An arithmetic type
+             * \param source The live angle to track (must stay alive until it's untracked or the interpolator is cleared)
+             * \param use_radians Whether the angle is measured in radians (true) or degrees (false)
+             * \returns A reference to the tracked state that stays valid until it's untracked; it's also the handle that bengine::state_interpolator::untrack takes
+             */
+            template <class type> bengine::interpolated_state<type>& track_angle(type *source, const bool &use_radians = true) {
+                static_assert(std::is_arithmetic<type>::value, "Template type \"type\" must be an arithmetic type (int, long, float, double, etc)");
+                this->states.emplace_back(new bengine::interpolated_state<type>(source, use_radians ? C_2PI : 360.0));
+                return *static_cast<bengine::interpolated_state<type>*>(this->states.back().get());
+            }
+            /** Stop tracking a value; do this before its source goes away (the state that was passed in is destroyed, so don't use it afterwards)
+             * \param state The reference returned by bengine::state_interpolator::track or bengine::state_interpolator::track_angle
+             * \returns Whether the state was being tracked
+             */
+            bool untrack(const bengine::base_interpolated_state &state) {
+                const auto position = std::find_if(this->states.begin(), this->states.end(), [&state](const std::unique_ptr<bengine::base_interpolated_state> &tracked) {
+                    return tracked.get() == &state;
+                });
+                if (position == this->states.end()) {
+                    return false;
+                }
+                this->states.erase(position);
+                return true;
+            }
+            // \brief Stop tracking everything
+            void clear() {
+                this->states.clear();
+            }
+
+            /** Get the amount of things being tracked
+             * \returns The amount of things being tracked
+             */
+            std::size_t get_size() const {
+                return this->states.size();
+            }
+
+            // \brief Copy every tracked live value into its previous value (called by bengine::loop before each computation step)
+            void store_previous() {
+                for (std::size_t i = 0; i < this->states.size(); i++) {
+                    this->states[i]->store_previous();
+                }
+            }
+    };
+}
+
+#endif // BENGINE_INTERPOLATION_hpp
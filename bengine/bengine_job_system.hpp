@@ -0,0 +1,339 @@
+#ifndef BENGINE_JOB_SYSTEM_hpp
+#define BENGINE_JOB_SYSTEM_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bengine {
+    // \brief A count of unfinished jobs that can be waited on as a group and that other jobs can depend on
+    class job_counter {
+        friend class job_system;
+
+        private:
+            // \brief The amount of jobs attached to this counter that haven't finished yet
+            std::atomic<std::size_t> pending = 0;
+            // \brief Guards bengine::job_counter::continuations and the moment that bengine::job_counter::pending reaches zero
+            mutable std::mutex continuation_mutex;
+            // \brief Jobs that are waiting for this counter to reach zero before they get submitted
+            std::vector<std::function<void()>> continuations;
+
+        public:
+            // \brief bengine::job_counter constructor
+            job_counter() {}
+            // \brief bengine::job_counter deconstructor
+            ~job_counter() {}
+
+            job_counter(const bengine::job_counter &rhs) = delete;
+            bengine::job_counter& operator=(const bengine::job_counter &rhs) = delete;
+
+            /** Check whether every job attached to this counter has finished
+             * \returns Whether every job attached to this counter has finished
+             */
+            bool is_done() const {
+                return this->pending.load(std::memory_order_acquire) == 0;
+            }
+            /** Get the amount of jobs attached to this counter that haven't finished yet
+             * \returns The amount of jobs attached to this counter that haven't finished yet
+             */
+            std::size_t get_pending() const {
+                return this->pending.load(std::memory_order_acquire);
+            }
+    };
+
+    /** A pool of worker threads (one per extra core by default) that each keep their own queue of jobs and steal from each other whenever they run dry
+     *
+     * Any thread can submit jobs, and any thread that waits on a bengine::job_counter helps run jobs until the counter reaches zero, so waiting from inside a job or from compute() never deadlocks and the waiting thread's core isn't wasted
+     */
+    class job_system {
+        private:
+            // \brief A single unit of work and the counter it reports to
+            struct job {
+                // \brief The work to do
+                std::function<void()> task;
+                // \brief The counter to decrement once the work is done (can be NULL)
+                bengine::job_counter *counter = NULL;
+            };
+            // \brief A queue of jobs belonging to one worker; the owner takes from the back and thieves take from the front
+            struct job_queue {
+                // \brief Guards bengine::job_system::job_queue::jobs
+                std::mutex mutex;
+                // \brief The jobs in the queue
+                std::deque<bengine::job_system::job> jobs;
+            };
+
+            // \brief One queue per worker, plus an extra one for jobs submitted from threads that aren't workers
+            std::vector<std::unique_ptr<bengine::job_system::job_queue>> queues;
+            // \brief The worker threads
+            std::vector<std::thread> workers;
+            // \brief Whether the workers should keep running
+            std::atomic<bool> running = true;
+            // \brief The total amount of jobs sitting in all of the queues
+            std::atomic<std::size_t> queued_jobs = 0;
+            // \brief Which queue the next job from a thread that isn't a worker should go to
+            std::atomic<std::size_t> next_queue = 0;
+            // \brief Guards sleeping/waking the workers
+            std::mutex sleep_mutex;
+            // \brief Wakes workers up when jobs are submitted
+            std::condition_variable sleep_condition;
+
+            /** Get the index of the queue that belongs to the current thread
+             * \returns The index of the queue belonging to the current thread if it is one of this system's workers, otherwise -1
+             */
+            int get_worker_index() const {
+                return bengine::job_system::current_system() == this ? bengine::job_system::current_index() : -1;
+            }
+            /** Get a per-thread reference to the job system that the current thread works for
+             * \returns A per-thread reference to the job system that the current thread works for (NULL for threads that aren't workers)
+             */
+            static const bengine::job_system*& current_system() {
+                static thread_local const bengine::job_system *system = NULL;
+                return system;
+            }
+            /** Get a per-thread reference to the index of the current thread's queue
+             * \returns A per-thread reference to the index of the current thread's queue
+             */
+            static int& current_index() {
+                static thread_local int index = -1;
+                return index;
+            }
+
+            /** Add a job to a queue and wake a worker up to run it
+             * \param task The work to do
+             * \param counter The counter to decrement once the work is done (can be NULL)
+             */
+            void push(std::function<void()> &&task, bengine::job_counter *counter) {
+                const int worker_index = this->get_worker_index();
+                const std::size_t queue_index = worker_index >= 0 ? worker_index : this->next_queue.fetch_add(1, std::memory_order_relaxed) % this->queues.size();
+                {
+                    std::lock_guard<std::mutex> lock(this->queues[queue_index]->mutex);
+                    this->queues[queue_index]->jobs.push_back({std::move(task), counter});
+                }
+                this->queued_jobs.fetch_add(1, std::memory_order_release);
+                // Taking the sleep mutex makes sure a worker that is about to sleep either sees the new job or is already waiting to be notified
+                {
+                    std::lock_guard<std::mutex> lock(this->sleep_mutex);
+                }
+                this->sleep_condition.notify_one();
+            }
+            /** Take a job to run, preferring the current thread's own queue and stealing from the others otherwise
+             * \param output Where to put the job that was taken
+             * \returns Whether a job was taken
+             */
+            bool take(bengine::job_system::job &output) {
+                if (this->queued_jobs.load(std::memory_order_acquire) == 0) {
+                    return false;
+                }
+                const int worker_index = this->get_worker_index();
+                if (worker_index >= 0) {
+                    bengine::job_system::job_queue &own_queue = *this->queues[worker_index];
+                    std::lock_guard<std::mutex> lock(own_queue.mutex);
+                    if (!own_queue.jobs.empty()) {
+                        output = std::move(own_queue.jobs.back());
+                        own_queue.jobs.pop_back();
+                        this->queued_jobs.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                const std::size_t start = worker_index >= 0 ? worker_index + 1 : 0;
+                for (std::size_t i = 0; i < this->queues.size(); i++) {
+                    bengine::job_system::job_queue &victim = *this->queues[(start + i) % this->queues.size()];
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    if (!victim.jobs.empty()) {
+                        output = std::move(victim.jobs.front());
+                        victim.jobs.pop_front();
+                        this->queued_jobs.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                return false;
+            }
+            /** Run a job and then report to its counter, releasing anything that depended on the counter once it reaches zero
+             * \param current The job to run
+             */
+            void execute(bengine::job_system::job &current) {
+                current.task();
+                if (current.counter == NULL) {
+                    return;
+                }
+                // The counter is only touched while its mutex is held so that a waiter can't destroy it out from under this thread (see bengine::job_system::wait)
+                std::vector<std::function<void()>> released;
+                {
+                    std::lock_guard<std::mutex> lock(current.counter->continuation_mutex);
+                    if (current.counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        released.swap(current.counter->continuations);
+                    }
+                }
+                for (std::size_t i = 0; i < released.size(); i++) {
+                    released[i]();
+                }
+            }
+            /** The body of each worker thread
+             * \param index The index of the worker's own queue
+             */
+            void work(const int index) {
+                bengine::job_system::current_system() = this;
+                bengine::job_system::current_index() = index;
+
+                bengine::job_system::job current;
+                while (this->running) {
+                    if (this->take(current)) {
+                        this->execute(current);
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(this->sleep_mutex);
+                    this->sleep_condition.wait(lock, [this] { return !this->running || this->queued_jobs.load(std::memory_order_acquire) > 0; });
+                }
+            }
+
+        public:
+            /** bengine::job_system constructor
+             * \param worker_count The amount of worker threads to create (negative to create one for every core other than the current one)
+             */
+            job_system(const int &worker_count = -1) {
+                const int count = worker_count >= 0 ? worker_count : std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+                for (int i = 0; i <= count; i++) {
+                    this->queues.emplace_back(new bengine::job_system::job_queue());
+                }
+                for (int i = 0; i < count; i++) {
+                    this->workers.emplace_back(&bengine::job_system::work, this, i);
+                }
+            }
+            // \brief bengine::job_system deconstructor; stops and joins every worker (jobs that haven't started are discarded)
+            ~job_system() {
+                this->running = false;
+                {
+                    std::lock_guard<std::mutex> lock(this->sleep_mutex);
+                }
+                this->sleep_condition.notify_all();
+                for (std::size_t i = 0; i < this->workers.size(); i++) {
+                    this->workers[i].join();
+                }
+            }
+
+            job_system(const bengine::job_system &rhs) = delete;
+            bengine::job_system& operator=(const bengine::job_system &rhs) = delete;
+
+            /** Get the amount of worker threads
+             * \returns The amount of worker threads (not counting threads that help out while waiting)
+             */
+            std::size_t get_worker_count() const {
+                return this->workers.size();
+            }
+
+            /** Submit a job
+             * \param counter The counter to attach the job to
+             * \param task The work to do
+             */
+            void submit(bengine::job_counter &counter, std::function<void()> task) {
+                counter.pending.fetch_add(1, std::memory_order_acq_rel);
+                this->push(std::move(task), &counter);
+            }
+            /** Submit a job that won't start until every job attached to another counter has finished
+             * \param dependency The counter that needs to reach zero before the job can start
+             * \param counter The counter to attach the job to (counts the job as pending right away)
+             * \param task The work to do
+             */
+            void submit_after(bengine::job_counter &dependency, bengine::job_counter &counter, std::function<void()> task) {
+                counter.pending.fetch_add(1, std::memory_order_acq_rel);
+                {
+                    std::lock_guard<std::mutex> lock(dependency.continuation_mutex);
+                    if (!dependency.is_done()) {
+                        bengine::job_counter *counter_pointer = &counter;
+                        dependency.continuations.emplace_back([this, counter_pointer, task]() mutable {
+                            this->push(std::move(task), counter_pointer);
+                        });
+                        return;
+                    }
+                }
+                this->push(std::move(task), &counter);
+            }
+
+            /** Block until every job attached to a counter has finished, running queued jobs on the calling thread in the meantime; a counter should only be destroyed after it has been waited on
+             * \param counter The counter to wait on
+             */
+            void wait(const bengine::job_counter &counter) {
+                bengine::job_system::job current;
+                while (!counter.is_done()) {
+                    if (this->take(current)) {
+                        this->execute(current);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                // Whichever thread finished the last job might still be holding the counter's mutex
+                std::lock_guard<std::mutex> lock(counter.continuation_mutex);
+            }
+
+            /** Call a function for every index in [0, count) with the indices split into chunks that are spread across the workers; returns once every index has been handled
+             * \tparam function_type Something callable as void(std::size_t)
+             * \param count The amount of indices
+             * \param function The function to call for each index (must be safe to call from several threads at once)
+             * \param grain_size The amount of indices per job (0 to pick one automatically)
+             */
+            template <class function_type> void parallel_for(const std::size_t &count, const function_type &function, const std::size_t &grain_size = 0) {
+                if (count == 0) {
+                    return;
+                }
+                const std::size_t chunk_size = grain_size > 0 ? grain_size : std::max<std::size_t>(count / ((this->workers.size() + 1) * 4), 1);
+                bengine::job_counter counter;
+                for (std::size_t begin = 0; begin < count; begin += chunk_size) {
+                    const std::size_t end = std::min(begin + chunk_size, count);
+                    this->submit(counter, [&function, begin, end]() {
+                        for (std::size_t i = begin; i < end; i++) {
+                            function(i);
+                        }
+                    });
+                }
+                this->wait(counter);
+            }
+            /** Map every index in [0, count) to a value and combine all of the values, spreading the work across the workers
+             * \tparam type The type of value being produced
+             * \tparam map_type Something callable as type(std::size_t)
+             * \tparam reduce_type Something callable as type(const type&, const type&); should be associative
+             * \param count The amount of indices
+             * \param identity The value that doesn't change anything when combined (0 for sums, 1 for products, etc)
+             * \param map The function that turns an index into a value (must be safe to call from several threads at once)
+             * \param reduce The function that combines two values
+             * \param grain_size The amount of indices per job (0 to pick one automatically)
+             * \returns Every mapped value combined together (identity if count is 0)
+             */
+            template <class type, class map_type, class reduce_type> type parallel_reduce(const std::size_t &count, const type &identity, const map_type &map, const reduce_type &reduce, const std::size_t &grain_size = 0) {
+                if (count == 0) {
+                    return identity;
+                }
+                const std::size_t chunk_size = grain_size > 0 ? grain_size : std::max<std::size_t>(count / ((this->workers.size() + 1) * 4), 1);
+                // Each partial sits in its own struct so that std::vector<bool> can't pack neighbouring chunks into the same byte and have their jobs race on it
+                struct partial_slot {
+                    type value;
+                };
+                std::vector<partial_slot> partials((count + chunk_size - 1) / chunk_size, partial_slot{identity});
+                bengine::job_counter counter;
+                for (std::size_t chunk = 0; chunk < partials.size(); chunk++) {
+                    this->submit(counter, [&partials, &map, &reduce, chunk, chunk_size, count]() {
+                        const std::size_t end = std::min((chunk + 1) * chunk_size, count);
+                        type partial = partials[chunk].value;
+                        for (std::size_t i = chunk * chunk_size; i < end; i++) {
+                            partial = reduce(partial, map(i));
+                        }
+                        partials[chunk].value = partial;
+                    });
+                }
+                this->wait(counter);
+
+                type output = identity;
+                for (std::size_t i = 0; i < partials.size(); i++) {
+                    output = reduce(output, partials[i].value);
+                }
+                return output;
+            }
+    };
+}
+
+#endif // BENGINE_JOB_SYSTEM_hpp
@@ -1,36 +1,376 @@
 #ifndef BENGINE_LOOP_hpp
 #define BENGINE_LOOP_hpp
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
 #include "bengine_render_window.hpp"
+#include "bengine_asset_cache.hpp"
+#include "bengine_clock.hpp"
+#include "bengine_event_dispatcher.hpp"
+#include "bengine_input_recording.hpp"
+#include "bengine_interpolation.hpp"
+#include "bengine_job_system.hpp"
+#include "bengine_task_scheduler.hpp"
+#include "bengine_work_queue.hpp"
+#include "bengine_subsystem_scheduler.hpp"
 
 namespace bengine {
     // \brief A virtual class used to contain the basic looping mechanism required to seperate rendering/computing while maintaining consistent computational behavior
     class loop {
+        public:
+            // \brief What the loop should do when there is more simulation time to catch up on than bengine::loop::max_substeps computation steps can cover in a single frame
+            enum class overload_policy : unsigned char {
+                DROP_TIME,              // overload_policy that throws away any time that couldn't be simulated this frame (the simulation skips ahead)
+                SLOW_MOTION,            // overload_policy that carries up to a frame's worth of steps over to the next frame and throws away the rest (short hitches are caught up, long overloads play in slow motion)
+                ADAPTIVE_DELTA_TIME     // overload_policy that stretches delta_time (up to bengine::loop::max_delta_time_scale times) so that the backlog fits into the allowed steps, throwing away whatever still doesn't fit
+            };
+
+            // \brief Where the loop's input comes from
+            enum class input_mode : unsigned char {
+                LIVE,         // input_mode that takes input straight from SDL
+                RECORDING,    // input_mode that takes input straight from SDL while logging it to bengine::loop::input_log
+                REPLAYING     // input_mode that ignores SDL input (other than quitting and window events) and feeds bengine::loop::input_log back in instead
+            };
+
+            // \brief Measurements taken over a run of bengine::loop::run_ticks
+            struct tick_statistics {
+                // \brief How many computation steps actually ran (fewer than requested if the loop was stopped)
+                unsigned long long ticks = 0;
+                // \brief How much real time the whole run took (seconds)
+                double elapsed_time = 0.0;
+                // \brief How much simulation time the run covered (seconds)
+                long double simulated_time = 0.0;
+                // \brief The shortest time spent in a single call to compute() (seconds)
+                double min_compute_duration = 0.0;
+                // \brief The average time spent in a single call to compute() (seconds)
+                double mean_compute_duration = 0.0;
+                // \brief The longest time spent in a single call to compute() (seconds)
+                double max_compute_duration = 0.0;
+            };
+
         protected:
             // \brief How long the loop has been active (seconds)
             long double time = 0.0;
             // \brief How long each computation frame should take (in seconds)
             double delta_time = 0.01;
 
-            // \brief Whether the loop is running or not
-            bool loop_running = true;
+            // \brief The most computation steps that can happen within a single frame before the overload policy kicks in (0 for no limit)
+            unsigned int max_substeps = 8;
+            // \brief What to do when a frame has more computation steps due than bengine::loop::max_substeps
+            bengine::loop::overload_policy overload_policy = bengine::loop::overload_policy::DROP_TIME;
+            // \brief How many times larger than normal delta_time is allowed to get while using the ADAPTIVE_DELTA_TIME overload policy
+            double max_delta_time_scale = 4.0;
+            // \brief The total amount of simulation time that has been thrown away due to overloading (seconds)
+            long double dropped_time = 0.0;
+            // \brief The amount of frames that had more computation steps due than bengine::loop::max_substeps
+            unsigned long long clamped_frames = 0;
+
+            // \brief The frame limiter used to pace rendering frames; its target frame time follows the window's refresh rate unless bengine::loop::limit_to_refresh_rate is false
+            bengine::frame_limiter limiter;
+            // \brief Whether the frame limiter's target should follow the refresh rate of the window's monitor (true) or be left as set by the subclass (false)
+            bool limit_to_refresh_rate = true;
+            // \brief Whether a headless loop still calls render() (into the window's offscreen surface, where primitives are drawn by bengine::render_window's software rasterizer); off by default since there's usually nobody to show the frames to, but turn it on for things like capturing frames or testing render() without a display
+            bool render_while_headless = false;
+
+            // \brief How long the most recent frame took from start to start (seconds)
+            double frame_duration = 0.0;
+            // \brief How long was spent in compute() during the most recent frame, summed over every computation step (seconds)
+            double compute_duration = 0.0;
+            // \brief How long was spent clearing, rendering, and presenting during the most recent frame (seconds); zero if nothing was rendered
+            double render_duration = 0.0;
+            // \brief How long was spent on bengine::loop::sliced_work during the most recent frame (seconds)
+            double work_duration = 0.0;
+
+            // \brief State that should be rendered between its previous and current values; previous values are stored automatically before every computation step
+            bengine::state_interpolator interpolator;
+            // \brief How far the simulation is into the next computation step as a fraction of bengine::loop::delta_time, on the interval [0, 1); pass this to bengine::interpolated_state::get_blended when rendering (atomic so that a simulation thread can update it while the main thread renders)
+            std::atomic<double> interpolation_factor = 0.0;
+
+            // \brief A work-stealing pool with a worker for every extra core; use parallel_for/parallel_reduce or submit jobs to a bengine::job_counter and wait on it from within compute() or render()
+            bengine::job_system jobs;
+            // \brief Update functions that run at their own rates off of the loop's simulation clock (advanced after every compute()); register anything that doesn't need to run every computation step
+            bengine::subsystem_scheduler subsystems;
+            // \brief Resumable tasks that get a fixed slice of every frame (run right after the frame's computation steps); push work that would cause a hitch if it were done all at once
+            bengine::work_queue sliced_work;
+#if BENGINE_COROUTINES
+            // \brief Runs coroutines that wait on ticks, real time, or events (C++20 only); spawn bengine::task coroutines into it and they'll be resumed right before the compute() call that they're due on
+            bengine::task_scheduler tasks;
+#endif
+
+            // \brief Whether the loop is running or not (atomic so that a simulation thread and the main thread can both stop the loop)
+            std::atomic<bool> loop_running = true;
             // \brief Whether the renderer needs to update the visuals or not (saves on performance when nothing visual is happening)
             bool visuals_changed = true;
+            // \brief Whether the subclass has no simulation work left until the next event arrives; while set (and nothing needs rendering) the loop blocks instead of stepping, and it gets reset to false once the loop wakes up (only used by bengine::loop::run)
+            bool simulation_idle = false;
+            // \brief The counter value that an idle loop should wake up at even without any events (0 for no scheduled wake-up)
+            Uint64 wake_time = 0;
 
             // \brief The window that is interacted with and displays everything
-            bengine::render_window window = bengine::render_window("window", 1280, 720, SDL_WINDOW_SHOWN);
+            bengine::render_window window;
+            // \brief Textures and fonts shared by path, so that the same file is only ever loaded once; hold on to the handles it gives out for as long as the asset is used
+            bengine::asset_cache assets{this->window};
+            // \brief Loads textures in the background on bengine::loop::jobs; finished textures are uploaded at the start of every frame within the loader's upload budget, and bengine::texture_loader::get_texture hands out a placeholder until then
+            bengine::texture_loader texture_loads{this->jobs};
             // \brief The SDL_Event structure used to process events
             SDL_Event event;
-            // \brief The state of the keyboard; good for instantaneous feedback on which keys are pressed and which aren't
+            // \brief Handlers that get called for matching events before handle_event() does; register handlers here instead of switching on event types inside handle_event()
+            bengine::event_dispatcher event_handlers;
+            // \brief The events drained from SDL this frame (kept around so its memory is reused)
+            std::vector<SDL_Event> event_queue;
+            // \brief Whether runs of back-to-back mouse motion events should be merged into one before being dispatched (relative motion is summed, everything else comes from the last event of the run)
+            bool coalesce_mouse_motion = false;
+            // \brief The state of the keyboard; good for instantaneous feedback on which keys are pressed and which aren't (points at the replayed state while replaying)
             const Uint8 *keystate = SDL_GetKeyboardState(NULL);
+            // \brief The mouse's x-position relative to the window as of the current computation step (px); use this instead of SDL_GetMouseState so that replays reproduce it
+            int mouse_x = 0;
+            // \brief The mouse's y-position relative to the window as of the current computation step (px); use this instead of SDL_GetMouseState so that replays reproduce it
+            int mouse_y = 0;
+            // \brief The mouse button bitmask (as returned by SDL_GetMouseState) as of the current computation step
+            Uint32 mouse_buttons = 0;
+
+            // \brief Where the loop's input currently comes from
+            bengine::loop::input_mode active_input_mode = bengine::loop::input_mode::LIVE;
+            // \brief The input that is being recorded or replayed
+            bengine::input_recording input_log;
+            // \brief Whether the loop should stop once a replay runs out of ticks (true) or carry on with live input (false)
+            bool quit_after_replay = true;
+            // \brief The events for the computation step that is being replayed (kept around so its memory is reused)
+            std::vector<SDL_Event> replay_events;
 
             // \brief A virtual function that will be called whenever there is an event that needs to be addressed
             virtual void handle_event() = 0;
             // \brief A virtual function that will be called each computation frame to handle any non-rendering-related tasks
             virtual void compute() = 0;
-            // \brief A virtual function that will be called each rendering frame to handle all of the rendering-related tasks
+            // \brief A virtual function that will be called each rendering frame to handle all of the rendering-related tasks; bengine::loop::interpolation_factor is up to date when this is called (interpolated scenes should keep visuals_changed set while anything tracked is moving; partially redrawing windows can skip anything that fails bengine::render_window::needs_redraw)
             virtual void render() = 0;
 
+            // \brief Pass bengine::loop::event on to everything that wants it (the input log while recording, the task scheduler, the event handler table, and finally handle_event())
+            void dispatch_event() {
+                if (this->active_input_mode == bengine::loop::input_mode::RECORDING) {
+                    this->input_log.record_event(this->event);
+                }
+#if BENGINE_COROUTINES
+                this->tasks.handle_event(this->event);
+#endif
+                this->event_handlers.dispatch(this->event);
+                this->handle_event();
+            }
+            // \brief Handle the engine-side behavior for bengine::loop::event (quitting and window events) and then dispatch it
+            void process_event() {
+                switch (this->event.type) {
+                    case SDL_QUIT:
+                        this->loop_running = false;
+                        break;
+                    case SDL_WINDOWEVENT:
+                        this->window.handle_event(this->event.window);
+                        this->visuals_changed = true;
+                        break;
+                }
+                this->dispatch_event();
+            }
+            /** Pull every pending event out of SDL into bengine::loop::event_queue in a few large batches
+             * \returns How many events were pulled out
+             */
+            std::size_t drain_events() {
+                static const int batch_size = 64;
+                std::size_t drained = this->event_queue.size();
+                int peeked = 0;
+                do {
+                    this->event_queue.resize(drained + batch_size);
+                    peeked = SDL_PeepEvents(this->event_queue.data() + drained, batch_size, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+                    drained += peeked > 0 ? peeked : 0;
+                } while (peeked == batch_size);
+                this->event_queue.resize(drained);
+
+                if (this->coalesce_mouse_motion && drained > 1) {
+                    std::size_t kept = 0;
+                    for (std::size_t i = 0; i < this->event_queue.size(); i++) {
+                        if (kept > 0 && this->event_queue[i].type == SDL_MOUSEMOTION && this->event_queue[kept - 1].type == SDL_MOUSEMOTION && this->event_queue[i].motion.which == this->event_queue[kept - 1].motion.which) {
+                            const Sint32 xrel = this->event_queue[kept - 1].motion.xrel + this->event_queue[i].motion.xrel;
+                            const Sint32 yrel = this->event_queue[kept - 1].motion.yrel + this->event_queue[i].motion.yrel;
+                            this->event_queue[kept - 1] = this->event_queue[i];
+                            this->event_queue[kept - 1].motion.xrel = xrel;
+                            this->event_queue[kept - 1].motion.yrel = yrel;
+                        } else {
+                            this->event_queue[kept++] = this->event_queue[i];
+                        }
+                    }
+                    this->event_queue.resize(kept);
+                }
+                return this->event_queue.size();
+            }
+            /** Drain every pending event and dispatch them all, and update the mouse state; called once per frame (and once per step by bengine::loop::run_ticks) so events are handled even on frames where no computation step is due
+             *
+             * While replaying, SDL's own events are only used for quitting and window handling since the input comes from the log instead
+             */
+            virtual void poll_events() {
+                // Pumping first means that the mouse state and the keyboard state both match the events about to be handled
+                SDL_PumpEvents();
+                this->drain_events();
+
+                if (this->active_input_mode == bengine::loop::input_mode::REPLAYING) {
+                    for (std::size_t i = 0; i < this->event_queue.size(); i++) {
+                        switch (this->event_queue[i].type) {
+                            case SDL_QUIT:
+                                this->loop_running = false;
+                                break;
+                            case SDL_WINDOWEVENT:
+                                this->window.handle_event(this->event_queue[i].window);
+                                this->visuals_changed = true;
+                                break;
+                        }
+                    }
+                    this->event_queue.clear();
+                    return;
+                }
+
+                this->mouse_buttons = SDL_GetMouseState(&this->mouse_x, &this->mouse_y);
+                for (std::size_t i = 0; i < this->event_queue.size(); i++) {
+                    this->event = this->event_queue[i];
+                    this->process_event();
+                }
+                this->event_queue.clear();
+            }
+            /** Take the input for the computation step that's about to happen; called before each computation step
+             *
+             * While recording, the events dispatched since the previous step and the current keyboard/mouse state are logged as a tick; while replaying, the next logged tick is fed in instead
+             * \returns Whether there was input for the step (false only when a replay has just run out)
+             */
+            bool advance_input() {
+                if (this->active_input_mode == bengine::loop::input_mode::RECORDING) {
+                    this->input_log.record_tick(this->keystate, this->mouse_x, this->mouse_y, this->mouse_buttons, this->delta_time);
+                } else if (this->active_input_mode == bengine::loop::input_mode::REPLAYING) {
+                    return this->replay_tick();
+                }
+                return true;
+            }
+            /** Feed the next logged tick into handle_event() and the keyboard/mouse state, going back to live input once the log runs out
+             * \returns Whether there was a tick left to replay
+             */
+            bool replay_tick() {
+                if (!this->input_log.replay_tick(this->replay_events)) {
+                    this->halt_replaying();
+                    if (this->quit_after_replay) {
+                        this->loop_running = false;
+                    }
+                    return false;
+                }
+
+                this->keystate = this->input_log.get_keystate();
+                this->mouse_x = this->input_log.get_mouse_x();
+                this->mouse_y = this->input_log.get_mouse_y();
+                this->mouse_buttons = this->input_log.get_mouse_buttons();
+                // Any stretching done by the adaptive overload policy is replayed too so that every step gets the same delta_time it was recorded with
+                this->delta_time = this->input_log.get_delta_time();
+                for (std::size_t i = 0; i < this->replay_events.size(); i++) {
+                    this->event = this->replay_events[i];
+                    this->process_event();
+                }
+                return true;
+            }
+
+            /** Make sure an idle loop wakes up after a certain amount of time even if no events arrive (an earlier scheduled wake-up takes priority)
+             * \param seconds How long from now to wake up (seconds)
+             */
+            void schedule_wake(const double &seconds) {
+                const Uint64 requested_time = bengine::precision_clock::now() + bengine::precision_clock::to_ticks(seconds);
+                if (this->wake_time == 0 || requested_time < this->wake_time) {
+                    this->wake_time = requested_time;
+                }
+            }
+            /** Block until an event arrives or the scheduled wake-up time is reached, processing the event that woke the loop up (if any)
+             * \returns Whether the loop actually blocked (false if the scheduled wake-up time has already passed)
+             */
+            bool wait_while_idle() {
+                int wait_result = 0;
+                if (this->wake_time == 0) {
+                    wait_result = SDL_WaitEvent(&this->event);
+                } else {
+                    const Uint64 current_time = bengine::precision_clock::now();
+                    if (current_time >= this->wake_time) {
+                        this->wake_time = 0;
+                        this->simulation_idle = false;
+                        return false;
+                    }
+                    // Rounded up so that the loop doesn't wake up a hair early and immediately go back to sleep
+                    wait_result = SDL_WaitEventTimeout(&this->event, static_cast<int>(bengine::precision_clock::to_seconds(this->wake_time - current_time) * 1000) + 1);
+                }
+
+                if (wait_result == 1) {
+                    this->process_event();
+                } else if (this->wake_time != 0 && bengine::precision_clock::now() >= this->wake_time) {
+                    this->wake_time = 0;
+                }
+                this->simulation_idle = false;
+                return true;
+            }
+
+            /** Run as many computation steps as the accumulated time calls for, applying bengine::loop::max_substeps and the overload policy
+             * \param accumulator The amount of simulation time that is waiting to be computed (seconds); reduced by however much gets computed or dropped
+             */
+            void simulate(double &accumulator) {
+                // The regular delta_time is restored after the computation steps in case the adaptive overload policy stretches it
+                const double base_delta_time = this->delta_time;
+                const bool overloaded = this->max_substeps > 0 && accumulator >= base_delta_time * (this->max_substeps + 1);
+                if (overloaded) {
+                    this->clamped_frames++;
+                    if (this->overload_policy == bengine::loop::overload_policy::ADAPTIVE_DELTA_TIME) {
+                        this->delta_time = std::min(accumulator / this->max_substeps, base_delta_time * this->max_delta_time_scale);
+                    }
+                }
+
+                Uint64 step_start = 0;
+                unsigned int substeps = 0;
+                this->compute_duration = 0.0;
+                while (accumulator >= this->delta_time && (this->max_substeps == 0 || substeps < this->max_substeps)) {
+                    // The step that a replay runs out on has no recorded input, so the frame's steps end there; live input takes over from the next frame (unless the loop was told to quit after the replay)
+                    if (!this->advance_input()) {
+                        break;
+                    }
+
+                    this->interpolator.store_previous();
+#if BENGINE_COROUTINES
+                    this->tasks.tick();
+#endif
+                    step_start = bengine::precision_clock::now();
+                    this->compute();
+                    this->subsystems.tick(this->delta_time);
+                    this->compute_duration += bengine::precision_clock::seconds_since(step_start);
+
+                    this->time += this->delta_time;
+                    accumulator -= this->delta_time;
+                    substeps++;
+                }
+                this->delta_time = base_delta_time;
+
+                if (overloaded) {
+                    // Whole steps that are still left over get thrown away; only the slow-motion policy lets some of them carry over
+                    const double kept_time = this->overload_policy == bengine::loop::overload_policy::SLOW_MOTION ? base_delta_time * this->max_substeps : 0.0;
+                    const double excess_time = accumulator >= base_delta_time ? accumulator - std::fmod(accumulator, base_delta_time) - kept_time : 0.0;
+                    if (excess_time > 0) {
+                        this->dropped_time += excess_time;
+                        accumulator -= excess_time;
+                    }
+                }
+            }
+            // \brief Clear the window, call render(), and present the result while timing the whole thing; when the window is partially redrawing, only the dirty region is cleared and render() is clipped to it (see bengine::render_window::start_partial_redrawing)
+            void render_frame() {
+                const Uint64 render_start = bengine::precision_clock::now();
+                if (this->window.is_partially_redrawing() && this->window.begin_partial_redraw()) {
+                    this->render();
+                    this->window.end_partial_redraw();
+                } else {
+                    this->window.clear_renderer();
+                    this->render();
+                }
+                this->window.present_renderer();
+                this->render_duration = bengine::precision_clock::seconds_since(render_start);
+            }
+
         public:
             /** bengine::loop constructor; mainly creates the window that will be used
              * \param title The title of the window being created
@@ -39,9 +379,10 @@ namespace bengine {
              * \param flags SDL2 flags to create the window with
              * \param image_init_flags SDL2 image flags to initialize SDL_image with (-1 to not initialize)
              * \param use_TTF Whether to initialize SDL_ttf or not
+             * \param headless Whether to run without a window or the SDL video subsystem (for dedicated servers, batch simulations, etc); render() isn't called unless bengine::loop::render_while_headless is set, and the window draws into an offscreen surface instead
              */
-            loop(const char* title = "window", const Uint16 &width = 1920, const Uint16 &height = 1080, const Uint32 &flags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE, const int &image_init_flags = IMG_INIT_PNG, const bool &use_TTF = true) {
-                if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+            loop(const char* title = "window", const Uint16 &width = 1920, const Uint16 &height = 1080, const Uint32 &flags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE, const int &image_init_flags = IMG_INIT_PNG, const bool &use_TTF = true, const bool &headless = false) : window(title, width, height, flags, headless) {
+                if (SDL_Init(headless ? SDL_INIT_TIMER | SDL_INIT_EVENTS : SDL_INIT_VIDEO) < 0) {
                     std::cout << "Error initializing SDL2\nERROR: " << SDL_GetError() << "\n";
                 }
                 if (image_init_flags != -1 && IMG_Init(image_init_flags) != image_init_flags) {
@@ -54,70 +395,212 @@ namespace bengine {
                 this->window.set_title(title);
                 this->window.set_width(width);
                 this->window.set_height(height);
-                this->window.set_window_flags(flags);
                 this->window.set_base_width(width);
                 this->window.set_base_height(height);
 
-                SDL_StopTextInput();
+                if (!headless) {
+                    this->window.set_window_flags(flags);
+                    SDL_StopTextInput();
+                }
             }
             // \brief bengine::loop deconstructor; pretty much just handles some SDL cleanup
-            ~loop() {
+            virtual ~loop() {
+                // Members are destroyed after this body runs, so anything that needs SDL has to let go of it before SDL shuts down
+                this->assets.clear();
+                this->texture_loads.clear();
+
                 TTF_Quit();
                 IMG_Quit();
                 SDL_Quit();
             }
 
+            /** Get the total amount of simulation time that has been thrown away due to overloading
+             * \returns The total amount of simulation time that has been thrown away due to overloading (seconds)
+             */
+            long double get_dropped_time() const {
+                return this->dropped_time;
+            }
+            /** Get the amount of frames that had more computation steps due than the loop allows for in a single frame
+             * \returns The amount of frames that had more computation steps due than the loop allows for in a single frame
+             */
+            unsigned long long get_clamped_frames() const {
+                return this->clamped_frames;
+            }
+            // \brief Reset the dropped time and clamped frame counters back to zero
+            void reset_overload_counters() {
+                this->dropped_time = 0.0;
+                this->clamped_frames = 0;
+            }
+
+            /** Get where the loop's input currently comes from
+             * \returns Where the loop's input currently comes from
+             */
+            bengine::loop::input_mode get_input_mode() const {
+                return this->active_input_mode;
+            }
+            /** Start logging every event and the keyboard/mouse state for each computation step (throws away anything that was recorded or loaded before)
+             *
+             * Recording goes through bengine::loop::poll_events, so it doesn't cover bengine::threaded_loop
+             */
+            void start_recording() {
+                this->halt_replaying();
+                this->input_log.clear();
+                this->active_input_mode = bengine::loop::input_mode::RECORDING;
+            }
+            // \brief Stop recording while keeping whatever was recorded
+            void halt_recording() {
+                if (this->active_input_mode == bengine::loop::input_mode::RECORDING) {
+                    this->active_input_mode = bengine::loop::input_mode::LIVE;
+                }
+            }
+            /** Write whatever has been recorded to a file
+             * \param path The path of the file to write
+             * \returns 0 on success or a negative error code on failure
+             */
+            int save_recording(const char* path) const {
+                return this->input_log.save(path);
+            }
+            /** Start replaying the recorded (or loaded) input from its first tick; every computation step takes the next tick until the log runs out
+             *
+             * For a replay to match the original session, the subclass has to start from the same state it was in when recording started and only read input through handle_event(), bengine::loop::keystate, and the bengine::loop mouse members
+             */
+            void start_replaying() {
+                this->input_log.rewind();
+                this->active_input_mode = bengine::loop::input_mode::REPLAYING;
+            }
+            /** Load a recording from a file and start replaying it
+             * \param path The path of the file to read
+             * \returns 0 on success or a negative error code on failure (the loop stays on live input on failure)
+             */
+            int start_replaying(const char* path) {
+                this->halt_recording();
+                this->halt_replaying();
+                const int output = this->input_log.load(path);
+                if (output == 0) {
+                    this->start_replaying();
+                }
+                return output;
+            }
+            // \brief Stop replaying and go back to live input
+            void halt_replaying() {
+                if (this->active_input_mode == bengine::loop::input_mode::REPLAYING) {
+                    this->active_input_mode = bengine::loop::input_mode::LIVE;
+                    this->keystate = SDL_GetKeyboardState(NULL);
+                }
+            }
+
+            /** Get whether the loop is running without a window or not
+             * \returns Whether the loop is running without a window or not
+             */
+            bool is_headless() const {
+                return this->window.is_headless();
+            }
+
             /** The main function that handles the looping behavior and virtual function calling
              * \returns 0 (anything additional hasn't been added yet)
              */
-            int run() {
-                Uint32 start_ticks = 0;
-                Uint32 frame_ticks = 0;
-                double current_time = SDL_GetTicks() * 0.01;
-                long double new_time = 0.0;
-                long double frame_time = 0.0;
+            virtual int run() {
+                Uint64 current_time = bengine::precision_clock::now();
+                Uint64 new_time = 0;
                 double accumulator = 0.0;
 
+                this->limiter.reset();
                 while (this->loop_running) {
-                    start_ticks = SDL_GetTicks();
-                    new_time = SDL_GetTicks() * 0.01;
-                    frame_time = new_time - current_time;
-                    current_time = new_time;
-                    accumulator += frame_time;
-
-                    while (accumulator >= this->delta_time) {
-                        while (SDL_PollEvent(&this->event)) {
-                            switch (this->event.type) {
-                                case SDL_QUIT:
-                                    this->loop_running = false;
-                                    break;
-                                case SDL_WINDOWEVENT:
-                                    this->window.handle_event(this->event.window);
-                                    this->visuals_changed = true;
-                                    break;
-                            }
-                            this->handle_event();
-                        }
+                    if (this->is_headless()) {
+                        // There is nothing to present, so frames only need to happen as often as computation steps do
+                        this->limiter.set_target_frame_time(this->delta_time);
+                    } else if (this->limit_to_refresh_rate) {
+                        this->limiter.set_target_rate(this->window.get_refresh_rate());
+                    }
 
-                        this->compute();
+                    new_time = bengine::precision_clock::now();
+                    this->frame_duration = bengine::precision_clock::seconds_between(current_time, new_time);
+                    current_time = new_time;
+                    accumulator += this->frame_duration;
 
-                        this->time += this->delta_time;
-                        accumulator -= this->delta_time;
+                    this->poll_events();
+                    this->simulate(accumulator);
+                    this->subsystems.frame(this->frame_duration);
+                    this->work_duration = this->sliced_work.run();
+                    // Textures that finish loading replace their placeholders, which has to be shown
+                    if (this->window.upload_textures(this->texture_loads) > 0) {
+                        this->visuals_changed = true;
                     }
 
-                    if (this->visuals_changed) {
+                    this->interpolation_factor = std::min(accumulator / this->delta_time, 1.0);
+                    this->render_duration = 0.0;
+                    // Invalidating part of a partially redrawing window counts as a visual change
+                    if (this->visuals_changed || this->window.has_dirty_rectangles()) {
                         this->visuals_changed = false;
-                        this->window.clear_renderer();
-                        this->render();
-                        this->window.present_renderer();
+                        if (!this->is_headless() || this->render_while_headless) {
+                            this->render_frame();
+                        }
                     }
 
-                    if ((frame_ticks = SDL_GetTicks() - start_ticks) < (Uint32)(1000 / this->window.get_refresh_rate())) {
-                        SDL_Delay(1000 / this->window.get_refresh_rate() - frame_ticks);
+                    // Time spent blocked isn't simulated, so the timebase is restarted afterwards to keep the simulation from jumping forwards
+                    // Replayed input doesn't come from SDL, so a replaying loop never blocks waiting on it (and neither does a loop with sliced work left to do or textures still loading)
+                    if (this->simulation_idle && !this->visuals_changed && !this->window.has_dirty_rectangles() && this->loop_running && this->active_input_mode != bengine::loop::input_mode::REPLAYING && this->sliced_work.is_empty() && !this->texture_loads.is_busy() && this->wait_while_idle()) {
+                        current_time = bengine::precision_clock::now();
+                        this->limiter.reset();
+                        continue;
                     }
+
+                    this->limiter.wait();
                 }
                 return 0;
             }
+            /** Run a set amount of computation steps without rendering anything and measure them; meant for headless loops (dedicated servers, batch simulations, benchmarks) but works on any loop
+             * \param tick_count How many computation steps to run (the run ends early if the loop stops running)
+             * \param fixed_rate Whether to space the steps out by delta_time like bengine::loop::run does (true) or run them back-to-back as fast as possible (false); a fixed-rate run that falls more than a step behind skips ahead instead of catching up
+             * \returns Measurements taken over the run
+             */
+            bengine::loop::tick_statistics run_ticks(const unsigned long long &tick_count, const bool &fixed_rate = false) {
+                bengine::loop::tick_statistics statistics;
+                const Uint64 run_start = bengine::precision_clock::now();
+                Uint64 step_start = 0;
+                double total_compute_duration = 0.0;
+                // Replayed ticks bring their own delta_time, so the regular one is put back after every step like bengine::loop::simulate does
+                const double base_delta_time = this->delta_time;
+
+                this->limiter.set_target_frame_time(fixed_rate ? this->delta_time : 0.0);
+                this->limiter.reset();
+                while (this->loop_running && statistics.ticks < tick_count) {
+                    this->poll_events();
+                    // The step that a replay runs out on has no recorded input, so it's skipped rather than computed with whatever the live input happens to be
+                    if (!this->advance_input()) {
+                        continue;
+                    }
+
+                    this->interpolator.store_previous();
+#if BENGINE_COROUTINES
+                    this->tasks.tick();
+#endif
+                    step_start = bengine::precision_clock::now();
+                    this->compute();
+                    this->subsystems.tick(this->delta_time);
+                    this->compute_duration = bengine::precision_clock::seconds_since(step_start);
+
+                    this->time += this->delta_time;
+                    statistics.simulated_time += this->delta_time;
+                    total_compute_duration += this->compute_duration;
+                    if (statistics.ticks == 0 || this->compute_duration < statistics.min_compute_duration) {
+                        statistics.min_compute_duration = this->compute_duration;
+                    }
+                    if (this->compute_duration > statistics.max_compute_duration) {
+                        statistics.max_compute_duration = this->compute_duration;
+                    }
+                    statistics.ticks++;
+                    this->delta_time = base_delta_time;
+
+                    this->limiter.wait();
+                }
+
+                statistics.elapsed_time = bengine::precision_clock::seconds_since(run_start);
+                if (statistics.ticks > 0) {
+                    statistics.mean_compute_duration = total_compute_duration / statistics.ticks;
+                }
+                return statistics;
+            }
     };
 }
 
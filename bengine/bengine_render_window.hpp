@@ -4,9 +4,21 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "bengine_camera_2d.hpp"
+#include "bengine_command_buffer.hpp"
+#include "bengine_font.hpp"
+#include "bengine_software_rasterizer.hpp"
+#include "bengine_text_cache.hpp"
 #include "bengine_texture.hpp"
+#include "bengine_texture_atlas.hpp"
+#include "bengine_texture_loader.hpp"
 #include "btils_main.hpp"
 
 namespace bengine {
@@ -61,6 +73,10 @@ namespace bengine {
             SDL_Window *window = NULL;
             // \brief The SDL_Renderer that the whole class is based around
             SDL_Renderer *renderer = NULL;
+            // \brief The offscreen surface that a headless window's software renderer draws into (NULL for regular windows)
+            SDL_Surface *headless_surface = NULL;
+            // \brief The title of a headless window (regular windows keep their title in the SDL_Window)
+            std::string headless_title;
 
             // \brief The width of the window (px)
             int width;
@@ -71,6 +87,9 @@ namespace bengine {
             // \brief Half of the height of the window (px) (useful for referencing the center of the window)
             int height_2;
 
+            // \brief The refresh rate of the monitor that the window is on (Hz); cached since fetching it requires a couple of display queries
+            int refresh_rate = 60;
+
             // \brief Whether the window is fullscreen or not
             bool is_fullscreen = false;
 
@@ -92,21 +111,168 @@ namespace bengine {
             // \brief The factor used to stretch a y-input when bengine::render_window::stretch_graphics is true
             double y_stretch_factor;
 
-            // \brief The SDL_Texture that is used whenever the window's dummy texture is initialized and drawn to
+            // \brief The SDL_Texture that is used whenever the window's dummy texture is initialized and drawn to (it's a target from the render target pool)
             SDL_Texture *dummy_texture = NULL;
+            // \brief The handle of the pooled render target that the dummy texture lives in (0 if it hasn't been initialized)
+            unsigned int dummy_target = 0;
             // \brief The SDL_PixelFormat that the window's dummy texture will use
             SDL_PixelFormat dummy_pixel_format;
-            // \brief Whether the renderer is targeting the window (false) or the dummy texture
+            // \brief Whether the renderer is targeting the window (false) or an offscreen texture (the dummy texture or a pooled render target)
             bool render_target = false;
+            // \brief The texture that the renderer is currently targeting (NULL for the window)
+            SDL_Texture *current_target = NULL;
+
+            // \brief An offscreen render target owned by the window's render target pool
+            struct pooled_render_target {
+                // \brief The handle that the target is acquired under (0 while it's sitting unused in the pool)
+                unsigned int id;
+                // \brief The target texture
+                SDL_Texture *texture;
+                // \brief The width of the texture (px)
+                int width;
+                // \brief The height of the texture (px)
+                int height;
+                // \brief The pixel format of the texture
+                Uint32 format;
+            };
+            // \brief Every render target the window has made, both acquired and unused
+            std::vector<bengine::render_window::pooled_render_target> render_targets;
+            // \brief The handle that the next acquired render target will get
+            unsigned int next_render_target_id = 1;
+            // \brief The handles of the render targets that were acquired by name
+            std::unordered_map<std::string, unsigned int> named_render_targets;
+            // \brief The textures that bengine::render_window::pop_render_target goes back to, most recently pushed last (NULL for the window)
+            std::vector<SDL_Texture*> render_target_stack;
+
+            // \brief Whether the window only redraws the parts of itself that have been invalidated (see bengine::render_window::start_partial_redrawing)
+            bool partial_redraw = false;
+            // \brief The persistent back buffer that partial redraws draw into; it keeps everything that wasn't redrawn from the frames before
+            SDL_Texture *back_buffer = NULL;
+            // \brief The width of bengine::render_window::back_buffer (px)
+            int back_buffer_width = 0;
+            // \brief The height of bengine::render_window::back_buffer (px)
+            int back_buffer_height = 0;
+            // \brief The texture that bengine::render_window::target_renderer_at_window targets (NULL for the window itself, or the back buffer during a partial redraw)
+            SDL_Texture *window_target = NULL;
+            // \brief The regions that need to be redrawn (already stretched)
+            std::vector<SDL_Rect> dirty_rectangles;
+            // \brief The smallest rectangle containing every dirty rectangle (already stretched); what partial redraws get clipped to
+            SDL_Rect dirty_bounds = {0, 0, 0, 0};
+            // \brief The most dirty rectangles that are tracked before they're all merged into their bounds
+            static const std::size_t dirty_rectangle_limit = 64;
+
+            // \brief A single quad waiting in the sprite batch
+            struct batched_sprite {
+                // \brief The texture to draw the quad with
+                SDL_Texture *texture;
+                // \brief The blend mode to draw the quad with
+                SDL_BlendMode blend_mode;
+                // \brief The layer that the quad is drawn on (lower layers are drawn first)
+                int layer;
+                // \brief The corners of the quad (top-left, top-right, bottom-right, bottom-left before any rotation)
+                SDL_Vertex vertices[4];
+            };
+            // \brief Sprites that have been batched but not drawn yet
+            std::vector<bengine::render_window::batched_sprite> sprite_batch;
+            // \brief The order to draw bengine::render_window::sprite_batch in (kept around so its memory is reused)
+            std::vector<std::size_t> sprite_batch_order;
+            // \brief The vertices of the group being submitted (kept around so its memory is reused)
+            std::vector<SDL_Vertex> batch_vertices;
+            // \brief The indices of the group being submitted (kept around so its memory is reused)
+            std::vector<int> batch_indices;
+            // \brief How many SDL_RenderGeometry calls the most recent sprite batch flush took
+            unsigned int sprite_batch_draw_calls = 0;
+            // \brief How many world-space draws have been thrown out by their camera since the window last presented
+            unsigned int culled_draws = 0;
+            // \brief The texture that was most recently queried for its size and blend mode (saves a query for every sprite when sprites share a texture; forgotten whenever the batch is flushed or discarded in case the texture gets changed or destroyed)
+            SDL_Texture *queried_texture = NULL;
+            // \brief The width of bengine::render_window::queried_texture (px)
+            int queried_width = 0;
+            // \brief The height of bengine::render_window::queried_texture (px)
+            int queried_height = 0;
+            // \brief The blend mode of bengine::render_window::queried_texture
+            SDL_BlendMode queried_blend_mode = SDL_BLENDMODE_BLEND;
+
+            // \brief The kinds of primitives that the primitive batch holds
+            enum class primitive_kind : Uint8 {
+                FILLED_RECTANGLE = 0,
+                FILLED_ELLIPSE = 1,
+                RECTANGLE = 2,
+                LINE = 3,
+                ELLIPSE = 4,
+                ANTIALIASED_ELLIPSE = 5
+            };
+            // \brief A single primitive waiting in the primitive batch (pixels are stored as lines that start and end at the same point)
+            struct batched_primitive {
+                // \brief The layer that the primitive is drawn on (lower layers are drawn first)
+                int layer;
+                // \brief What kind of primitive it is
+                bengine::render_window::primitive_kind kind;
+                // \brief The color to draw the primitive with
+                SDL_Color color;
+                // \brief The shape of the primitive (already stretched); lines store their endpoints as {x1, y1, x2, y2} and ellipses store {center x, center y, x-radius, y-radius}
+                SDL_Rect shape;
+            };
+            // \brief Primitives that have been batched but not drawn yet
+            std::vector<bengine::render_window::batched_primitive> primitive_batch;
+            // \brief The order to draw bengine::render_window::primitive_batch in (kept around so its memory is reused)
+            std::vector<std::size_t> primitive_batch_order;
+            // \brief The points of the run being submitted (kept around so its memory is reused)
+            std::vector<SDL_Point> batch_points;
+            // \brief The rectangles of the run being submitted (kept around so its memory is reused)
+            std::vector<SDL_Rect> batch_rectangles;
+            // \brief How many SDL draw calls the most recent primitive batch flush took
+            unsigned int primitive_batch_draw_calls = 0;
+
+            // \brief A pixel of an anti-aliased ellipse outline, relative to the ellipse's center
+            struct antialiased_pixel {
+                // \brief x-offset from the center (px)
+                int x;
+                // \brief y-offset from the center (px)
+                int y;
+                // \brief How much of the pixel the outline covers, on the interval (0, 1]
+                float coverage;
+            };
+            // \brief The most ellipse sizes that the span and anti-aliasing caches hold before they're emptied
+            static const std::size_t ellipse_cache_limit = 1024;
+            // \brief Half-width span tables keyed by bengine::render_window::get_ellipse_key; entry i is how far the ellipse reaches to either side of its center i rows above/below the center
+            std::unordered_map<Uint64, std::vector<int>> ellipse_spans;
+            // \brief Anti-aliased outline pixels keyed by bengine::render_window::get_ellipse_key (already mirrored into all 4 quadrants)
+            std::unordered_map<Uint64, std::vector<bengine::render_window::antialiased_pixel>> antialiased_ellipses;
+
+            // \brief Text that has already been rendered by the TTF_Font render_text functions
+            bengine::text_cache text_textures;
+
+            // \brief A command waiting to be replayed, found by its buffer and its place in that buffer
+            struct replayed_command {
+                // \brief The layer that the command was recorded on
+                int layer;
+                // \brief The buffer that the command is in
+                const bengine::command_buffer *buffer;
+                // \brief Where the command is in its buffer
+                std::size_t index;
+            };
+            // \brief Command buffers that have been submitted and will be replayed when the window presents (or finishes a partial redraw)
+            std::vector<const bengine::command_buffer*> submitted_commands;
+            // \brief The order that commands are replayed in (kept around so its memory is reused)
+            std::vector<bengine::render_window::replayed_command> replay_order;
+
+            // \brief Draws primitives straight into a headless window's offscreen surface instead of going through SDL's generic software renderer
+            bengine::software_rasterizer rasterizer;
+            // \brief Whether a headless window draws its primitives with bengine::render_window::rasterizer (on by default)
+            bool software_rasterizing = true;
+            // \brief The renderer's current drawing color (kept here so that the rasterizer doesn't have to ask SDL for it)
+            SDL_Color draw_color = {0, 0, 0, 255};
 
             /** Pretty much does the same thing as SDL_SetRenderDrawColor, but will also print an error if something goes wrong
              * \param color The SDL_Color to change the renderer's color to
              * \returns 0 on success or a negative error code on failure
              */
             int change_draw_color(const SDL_Color &color) {
+                this->draw_color = color;
                 const int output = SDL_SetRenderDrawColor(this->renderer, color.r, color.g, color.b, color.a);
                 if (output != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to change its renderer's drawing color [bengine::render_window::change_draw_color]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to change its renderer's drawing color [bengine::render_window::change_draw_color]";
                     this->print_error();
                 }
                 return output;
@@ -115,6 +281,103 @@ namespace bengine {
             void print_error() const {
                 std::cout << "\nERROR [" << SDL_GetTicks() << "]: " << SDL_GetError() << "\n";
             }
+
+            /** Check whether primitives should go to bengine::render_window::rasterizer instead of SDL (only while a headless window is drawing into its own surface; offscreen targets are textures that only SDL can draw into)
+             * \returns Whether primitives should be rasterized on the CPU
+             */
+            bool can_rasterize() const {
+                return this->software_rasterizing && this->headless_surface != NULL && this->current_target == NULL && this->rasterizer.has_target();
+            }
+            /** Get bengine::render_window::rasterizer ready to draw: SDL has to finish whatever it has queued for the surface first so that everything lands in order, and the rasterizer picks up the renderer's clip rectangle
+             * \returns The renderer's draw blend mode
+             */
+            SDL_BlendMode prepare_rasterizer() {
+                SDL_RenderFlush(this->renderer);
+                SDL_Rect clip;
+                SDL_RenderGetClipRect(this->renderer, &clip);
+                this->rasterizer.set_clip(SDL_RenderIsClipEnabled(this->renderer) ? &clip : NULL);
+                SDL_BlendMode output = SDL_BLENDMODE_NONE;
+                SDL_GetRenderDrawBlendMode(this->renderer, &output);
+                return output;
+            }
+            /** Clear the renderer with the drawing color, like SDL_RenderClear
+             * \returns 0 on success or a negative error code on failure
+             */
+            int submit_clear() {
+                if (!this->can_rasterize()) {
+                    return SDL_RenderClear(this->renderer);
+                }
+                this->prepare_rasterizer();
+                this->rasterizer.clear(this->draw_color);
+                return 0;
+            }
+            /** Draw pixels with the drawing color, like SDL_RenderDrawPoints
+             * \param points The pixels
+             * \param count How many pixels there are
+             * \returns 0 on success or a negative error code on failure
+             */
+            int submit_points(const SDL_Point *points, const int &count) {
+                if (!this->can_rasterize()) {
+                    return SDL_RenderDrawPoints(this->renderer, points, count);
+                }
+                this->rasterizer.draw_points(points, count, this->draw_color, this->prepare_rasterizer());
+                return 0;
+            }
+            /** Draw a line with the drawing color, like SDL_RenderDrawLine
+             * \param x1 x-position of the starting point (px)
+             * \param y1 y-position of the starting point (px)
+             * \param x2 x-position of the ending point (px)
+             * \param y2 y-position of the ending point (px)
+             * \returns 0 on success or a negative error code on failure
+             */
+            int submit_line(const int &x1, const int &y1, const int &x2, const int &y2) {
+                if (!this->can_rasterize()) {
+                    return SDL_RenderDrawLine(this->renderer, x1, y1, x2, y2);
+                }
+                this->rasterizer.draw_line(x1, y1, x2, y2, this->draw_color, this->prepare_rasterizer());
+                return 0;
+            }
+            /** Fill or outline rectangles with the drawing color, like SDL_RenderFillRects and SDL_RenderDrawRects
+             * \param rectangles The rectangles
+             * \param count How many rectangles there are
+             * \param filled Whether to fill the rectangles or just draw their outlines
+             * \returns 0 on success or a negative error code on failure
+             */
+            int submit_rectangles(const SDL_Rect *rectangles, const int &count, const bool &filled) {
+                if (!this->can_rasterize()) {
+                    return filled ? SDL_RenderFillRects(this->renderer, rectangles, count) : SDL_RenderDrawRects(this->renderer, rectangles, count);
+                }
+                const SDL_BlendMode blend_mode = this->prepare_rasterizer();
+                if (filled) {
+                    this->rasterizer.fill_rectangles(rectangles, count, this->draw_color, blend_mode);
+                } else {
+                    this->rasterizer.draw_rectangles(rectangles, count, this->draw_color, blend_mode);
+                }
+                return 0;
+            }
+            /** Submit bengine::render_window::batch_vertices and bengine::render_window::batch_indices as untextured geometry with the renderer's draw blend mode; the rasterizer expects one single-colored convex quad for every 4 vertices with its corners in order (like the primitive batch makes), and axis-aligned quads with the top-left corner first are filled as rectangles
+             * \returns 0 on success or a negative error code on failure
+             */
+            int submit_quads() {
+                if (!this->can_rasterize()) {
+                    return SDL_RenderGeometry(this->renderer, NULL, this->batch_vertices.data(), static_cast<int>(this->batch_vertices.size()), this->batch_indices.data(), static_cast<int>(this->batch_indices.size()));
+                }
+                const SDL_BlendMode blend_mode = this->prepare_rasterizer();
+                for (std::size_t i = 0; i + 3 < this->batch_vertices.size(); i += 4) {
+                    const SDL_FPoint &top_left = this->batch_vertices[i].position;
+                    const SDL_FPoint &top_right = this->batch_vertices[i + 1].position;
+                    const SDL_FPoint &bottom_right = this->batch_vertices[i + 2].position;
+                    const SDL_FPoint &bottom_left = this->batch_vertices[i + 3].position;
+                    if (top_left.y != top_right.y || top_right.x != bottom_right.x || bottom_right.y != bottom_left.y || bottom_left.x != top_left.x) {
+                        const SDL_FPoint corners[4] = {top_left, top_right, bottom_right, bottom_left};
+                        this->rasterizer.fill_polygon(corners, 4, this->batch_vertices[i].color, blend_mode);
+                        continue;
+                    }
+                    const SDL_Rect rectangle = {static_cast<int>(std::lround(top_left.x)), static_cast<int>(std::lround(top_left.y)), static_cast<int>(std::lround(bottom_right.x - top_left.x)), static_cast<int>(std::lround(bottom_right.y - top_left.y))};
+                    this->rasterizer.fill_rectangles(&rectangle, 1, this->batch_vertices[i].color, blend_mode);
+                }
+                return 0;
+            }
  
             /** Scale an x-value (that is assumed to be) relative to the window's base width to one relative to the window's current width
              * \param x An x-value relative to the window's base width (px)
@@ -131,21 +394,502 @@ namespace bengine {
                 return y * this->y_stretch_factor;
             }
 
+            /** Make sure bengine::render_window::queried_texture holds the information for a texture
+             * \param texture The texture to query
+             * \returns 0 on success or a negative error code on failure
+             */
+            int query_texture(SDL_Texture *texture) {
+                if (texture == this->queried_texture) {
+                    return 0;
+                }
+                if (SDL_QueryTexture(texture, NULL, NULL, &this->queried_width, &this->queried_height) != 0 || SDL_GetTextureBlendMode(texture, &this->queried_blend_mode) != 0) {
+                    this->queried_texture = NULL;
+                    std::cout << "Window \"" << this->get_title() << "\" failed to query a texture for the sprite batch [bengine::render_window::query_texture]";
+                    this->print_error();
+                    return -1;
+                }
+                this->queried_texture = texture;
+                return 0;
+            }
+
+            /** Pack an SDL_Color into a single number so that colors can be sorted and compared quickly
+             * \param color The color to pack
+             * \returns The color as 0xRRGGBBAA
+             */
+            static Uint32 pack_color(const SDL_Color &color) {
+                return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) | (static_cast<Uint32>(color.b) << 8) | color.a;
+            }
+            /** Break a line down into its pixels using Bresenham's line algorithm (both endpoints are included like SDL_RenderDrawLine)
+             * \param line The endpoints of the line as {x1, y1, x2, y2}
+             * \param points Where to add the pixels
+             */
+            static void rasterize_line(const SDL_Rect &line, std::vector<SDL_Point> &points) {
+                int x = line.x, y = line.y;
+                const int dx = std::abs(line.w - line.x);
+                const int dy = -std::abs(line.h - line.y);
+                const int step_x = line.x < line.w ? 1 : -1;
+                const int step_y = line.y < line.h ? 1 : -1;
+                int error = dx + dy;
+                while (true) {
+                    points.push_back({x, y});
+                    if (x == line.w && y == line.h) {
+                        return;
+                    }
+                    const int doubled_error = error * 2;
+                    if (doubled_error >= dy) {
+                        error += dy;
+                        x += step_x;
+                    }
+                    if (doubled_error <= dx) {
+                        error += dx;
+                        y += step_y;
+                    }
+                }
+            }
+
+            /** Get the key that an ellipse size is cached under
+             * \param rx x-radius of the ellipse (px)
+             * \param ry y-radius of the ellipse (px)
+             * \returns The key that the ellipse size is cached under
+             */
+            static Uint64 get_ellipse_key(const int &rx, const int &ry) {
+                return (static_cast<Uint64>(static_cast<Uint32>(rx)) << 32) | static_cast<Uint32>(ry);
+            }
+            /** Get the half-width span table for an ellipse, computing and caching it the first time that size is asked for
+             *
+             * A pixel is inside if its center is inside the ellipse with radii rx + 1/2 and ry + 1/2 (the midpoint circle rule), which is checked with integers only while walking the half-width inward row by row
+             *
+             * \param rx x-radius of the ellipse (px) (must not be negative)
+             * \param ry y-radius of the ellipse (px) (must not be negative)
+             * \returns The span table; entry i is the half-width i rows above/below the center
+             */
+            const std::vector<int>& get_ellipse_spans(const int &rx, const int &ry) {
+                const Uint64 key = bengine::render_window::get_ellipse_key(rx, ry);
+                const auto cached = this->ellipse_spans.find(key);
+                if (cached != this->ellipse_spans.end()) {
+                    return cached->second;
+                }
+                if (this->ellipse_spans.size() >= bengine::render_window::ellipse_cache_limit) {
+                    this->ellipse_spans.clear();
+                }
+
+                std::vector<int> &spans = this->ellipse_spans[key];
+                spans.resize(ry + 1);
+                const long long a = (2LL * rx + 1) * (2LL * rx + 1);
+                const long long b = (2LL * ry + 1) * (2LL * ry + 1);
+                long long x = rx;
+                for (long long y = 0; y <= ry; y++) {
+                    while (x > 0 && 4 * x * x * b + 4 * y * y * a > a * b) {
+                        x--;
+                    }
+                    spans[y] = static_cast<int>(x);
+                }
+                return spans;
+            }
+            /** Get the pixels of an anti-aliased ellipse outline, computing and caching them the first time that size is asked for
+             *
+             * Like Wu's line algorithm, the outline is walked one column at a time where it's flatter than 45 degrees and one row at a time where it's steeper, splitting each step between the two pixels on either side of the exact edge
+             *
+             * \param rx x-radius of the ellipse (px) (must be positive)
+             * \param ry y-radius of the ellipse (px) (must be positive)
+             * \returns The outline pixels relative to the center
+             */
+            const std::vector<bengine::render_window::antialiased_pixel>& get_antialiased_ellipse(const int &rx, const int &ry) {
+                const Uint64 key = bengine::render_window::get_ellipse_key(rx, ry);
+                const auto cached = this->antialiased_ellipses.find(key);
+                if (cached != this->antialiased_ellipses.end()) {
+                    return cached->second;
+                }
+                if (this->antialiased_ellipses.size() >= bengine::render_window::ellipse_cache_limit) {
+                    this->antialiased_ellipses.clear();
+                }
+
+                std::vector<bengine::render_window::antialiased_pixel> &pixels = this->antialiased_ellipses[key];
+                // Adds a pixel to every quadrant without doubling up pixels that sit on an axis
+                const auto add_mirrored = [&pixels](const int &x, const int &y, const float &coverage) {
+                    if (coverage <= 0.0f) {
+                        return;
+                    }
+                    pixels.push_back({x, y, coverage});
+                    if (x != 0) {
+                        pixels.push_back({-x, y, coverage});
+                    }
+                    if (y != 0) {
+                        pixels.push_back({x, -y, coverage});
+                        if (x != 0) {
+                            pixels.push_back({-x, -y, coverage});
+                        }
+                    }
+                };
+
+                const double rx2 = static_cast<double>(rx) * rx;
+                const double ry2 = static_cast<double>(ry) * ry;
+                // Where the outline's slope passes 45 degrees
+                const int x_turn = static_cast<int>(std::floor(rx2 / std::sqrt(rx2 + ry2)));
+                for (int x = 0; x <= x_turn; x++) {
+                    const double edge = ry * std::sqrt(std::max(0.0, 1.0 - x * x / rx2));
+                    const int inner = static_cast<int>(std::floor(edge));
+                    const float fraction = static_cast<float>(edge - inner);
+                    add_mirrored(x, inner, 1.0f - fraction);
+                    add_mirrored(x, inner + 1, fraction);
+                }
+                for (int y = 0; ; y++) {
+                    const double edge = rx * std::sqrt(std::max(0.0, 1.0 - y * y / ry2));
+                    const int inner = static_cast<int>(std::floor(edge));
+                    // The columns above already cover everything from here up
+                    if (inner <= x_turn) {
+                        break;
+                    }
+                    const float fraction = static_cast<float>(edge - inner);
+                    add_mirrored(inner, y, 1.0f - fraction);
+                    add_mirrored(inner + 1, y, fraction);
+                }
+                return pixels;
+            }
+            /** Add the spans that make up a filled ellipse to a list of rectangles
+             * \param shape The ellipse as {center x, center y, x-radius, y-radius}
+             * \param rectangles Where to add the spans
+             */
+            void append_ellipse_spans(const SDL_Rect &shape, std::vector<SDL_Rect> &rectangles) {
+                const std::vector<int> &spans = this->get_ellipse_spans(shape.w, shape.h);
+                for (int y = 0; y <= shape.h; y++) {
+                    rectangles.push_back({shape.x - spans[y], shape.y + y, spans[y] * 2 + 1, 1});
+                    if (y != 0) {
+                        rectangles.push_back({shape.x - spans[y], shape.y - y, spans[y] * 2 + 1, 1});
+                    }
+                }
+            }
+            /** Add the pixels that make up an ellipse outline to a list of points; each row gets the pixels that the next row out doesn't reach, so the outline is always connected
+             * \param shape The ellipse as {center x, center y, x-radius, y-radius}
+             * \param points Where to add the pixels
+             */
+            void append_ellipse_outline(const SDL_Rect &shape, std::vector<SDL_Point> &points) {
+                const std::vector<int> &spans = this->get_ellipse_spans(shape.w, shape.h);
+                for (int y = 0; y <= shape.h; y++) {
+                    const int outer = spans[y];
+                    const int inner = std::min(y < shape.h ? spans[y + 1] + 1 : 0, outer);
+                    for (int x = inner; x <= outer; x++) {
+                        points.push_back({shape.x + x, shape.y + y});
+                        if (x != 0) {
+                            points.push_back({shape.x - x, shape.y + y});
+                        }
+                        if (y != 0) {
+                            points.push_back({shape.x + x, shape.y - y});
+                            if (x != 0) {
+                                points.push_back({shape.x - x, shape.y - y});
+                            }
+                        }
+                    }
+                }
+            }
+            /** Add the quads that make up an anti-aliased ellipse outline to bengine::render_window::batch_vertices and bengine::render_window::batch_indices
+             * \param shape The ellipse as {center x, center y, x-radius, y-radius}
+             * \param color The color of the outline (its alpha gets scaled by each pixel's coverage)
+             */
+            void append_antialiased_ellipse(const SDL_Rect &shape, const SDL_Color &color) {
+                const std::vector<bengine::render_window::antialiased_pixel> &pixels = this->get_antialiased_ellipse(shape.w, shape.h);
+                for (std::size_t i = 0; i < pixels.size(); i++) {
+                    const Uint8 alpha = static_cast<Uint8>(color.a * pixels[i].coverage + 0.5f);
+                    if (alpha == 0) {
+                        continue;
+                    }
+                    const SDL_Color pixel_color = {color.r, color.g, color.b, alpha};
+                    const float left = static_cast<float>(shape.x + pixels[i].x);
+                    const float top = static_cast<float>(shape.y + pixels[i].y);
+                    const int base = static_cast<int>(this->batch_vertices.size());
+                    this->batch_vertices.push_back({{left, top}, pixel_color, {0.0f, 0.0f}});
+                    this->batch_vertices.push_back({{left + 1.0f, top}, pixel_color, {0.0f, 0.0f}});
+                    this->batch_vertices.push_back({{left + 1.0f, top + 1.0f}, pixel_color, {0.0f, 0.0f}});
+                    this->batch_vertices.push_back({{left, top + 1.0f}, pixel_color, {0.0f, 0.0f}});
+                    const int indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+                    this->batch_indices.insert(this->batch_indices.end(), indices, indices + 6);
+                }
+            }
+            /** Make the quad for a glyph placed by bengine::font::layout
+             * \param font The font that laid out the glyph
+             * \param glyph The placed glyph
+             * \param x x-position of the top-left corner of the text relative to the window (px)
+             * \param y y-position of the top-left corner of the text relative to the window (px)
+             * \param color The color of the text
+             * \param vertices Where to store the quad's 4 corners (top-left, top-right, bottom-right, bottom-left)
+             */
+            void make_glyph_quad(const bengine::font &font, const bengine::font::placed_glyph &glyph, const int &x, const int &y, const SDL_Color &color, SDL_Vertex *vertices) const {
+                SDL_Rect destination = {x + glyph.dst.x, y + glyph.dst.y, glyph.dst.w, glyph.dst.h};
+                if (this->stretch_graphics) {
+                    destination = {this->stretch_x(destination.x), this->stretch_y(destination.y), this->stretch_x(destination.w), this->stretch_y(destination.h)};
+                }
+                const float page_size = static_cast<float>(font.get_page_size());
+                const float u1 = glyph.frame.x / page_size;
+                const float v1 = glyph.frame.y / page_size;
+                const float u2 = (glyph.frame.x + glyph.frame.w) / page_size;
+                const float v2 = (glyph.frame.y + glyph.frame.h) / page_size;
+                const float left = static_cast<float>(destination.x);
+                const float top = static_cast<float>(destination.y);
+                const float right = static_cast<float>(destination.x + destination.w);
+                const float bottom = static_cast<float>(destination.y + destination.h);
+                vertices[0] = {{left, top}, color, {u1, v1}};
+                vertices[1] = {{right, top}, color, {u2, v1}};
+                vertices[2] = {{right, bottom}, color, {u2, v2}};
+                vertices[3] = {{left, bottom}, color, {u1, v2}};
+            }
+            /** Get a texture of some text, from the text cache if it's there or by rendering it through SDL_ttf (and caching it) if it isn't
+             * \param font The TTF_Font to use
+             * \param text The text to render
+             * \param wrap_width The maximum width for the text (px) (0 for no wrapping)
+             * \param color The color of the text
+             * \param width Where to store the width of the texture (px)
+             * \param height Where to store the height of the texture (px)
+             * \param cached Where to store whether the texture belongs to the cache (if it doesn't, the caller has to destroy it)
+             * \returns The texture, or NULL on failure
+             */
+            SDL_Texture* get_text_texture(TTF_Font *font, const char16_t *text, const Uint32 &wrap_width, const SDL_Color &color, int &width, int &height, bool &cached) {
+                SDL_Texture *output = this->text_textures.find(font, text, color, wrap_width, width, height);
+                if (output != NULL) {
+                    cached = true;
+                    return output;
+                }
+
+                SDL_Surface *surface = TTF_RenderUNICODE_Blended_Wrapped(font, (Uint16*)text, color, wrap_width);
+                if (surface == NULL) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render text [bengine::render_window::get_text_texture]";
+                    this->print_error();
+                    return NULL;
+                }
+                output = SDL_CreateTextureFromSurface(this->renderer, surface);
+                width = surface->w;
+                height = surface->h;
+                SDL_FreeSurface(surface);
+                surface = nullptr;
+                if (output == NULL) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to create a texture for text [bengine::render_window::get_text_texture]";
+                    this->print_error();
+                    return NULL;
+                }
+
+                cached = this->text_textures.insert(font, text, color, wrap_width, output, width, height);
+                return output;
+            }
+            /** Submit bengine::render_window::batch_vertices and bengine::render_window::batch_indices as blended, untextured geometry (the renderer's draw blend mode is put back afterwards)
+             * \returns 0 on success or a negative error code on failure
+             */
+            int render_blended_geometry() {
+                SDL_BlendMode previous_blend_mode = SDL_BLENDMODE_NONE;
+                SDL_GetRenderDrawBlendMode(this->renderer, &previous_blend_mode);
+                SDL_SetRenderDrawBlendMode(this->renderer, SDL_BLENDMODE_BLEND);
+                const int output = this->submit_quads();
+                SDL_SetRenderDrawBlendMode(this->renderer, previous_blend_mode);
+                return output;
+            }
+            /** Get which stage of a layer a kind of primitive is drawn in
+             * \param kind The kind of primitive
+             * \returns 0 for fills, 1 for rectangle outlines, 2 for pixels/lines/ellipse outlines, and 3 for anti-aliased outlines
+             */
+            static Uint8 get_draw_stage(const bengine::render_window::primitive_kind &kind) {
+                switch (kind) {
+                    case bengine::render_window::primitive_kind::FILLED_RECTANGLE:
+                    case bengine::render_window::primitive_kind::FILLED_ELLIPSE:
+                        return 0;
+                    case bengine::render_window::primitive_kind::RECTANGLE:
+                        return 1;
+                    case bengine::render_window::primitive_kind::LINE:
+                    case bengine::render_window::primitive_kind::ELLIPSE:
+                        return 2;
+                    default:
+                        return 3;
+                }
+            }
+            /** Get an ellipse in the form that the primitive batch stores it in, stretching it if needed
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx x-radius of the ellipse (px)
+             * \param ry y-radius of the ellipse (px)
+             * \returns The ellipse as {center x, center y, x-radius, y-radius}
+             */
+            SDL_Rect get_ellipse_shape(const int &x, const int &y, const int &rx, const int &ry) const {
+                if (this->stretch_graphics) {
+                    return {this->stretch_x(x), this->stretch_y(y), this->stretch_x(std::abs(rx)), this->stretch_y(std::abs(ry))};
+                }
+                return {x, y, std::abs(rx), std::abs(ry)};
+            }
+            /** Work out where a rectangle in the world lands in the window, counting it as culled if the camera can't see it
+             * \param camera The camera to look through
+             * \param x x-position of the top-left corner of the rectangle (world units)
+             * \param y y-position of the top-left corner of the rectangle (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \param dst Where to store the rectangle before it's rotated, relative to the window (px for all 4 metrics)
+             * \param angle How far the rectangle is rotated around its center in the world (degrees), which gets replaced with how far it's rotated on screen
+             * \returns Whether the rectangle is visible (dst and angle are left alone if it isn't)
+             */
+            bool place_in_view(const bengine::camera_2d &camera, const double &x, const double &y, const double &w, const double &h, SDL_Rect &dst, double &angle) {
+                // A rotated rectangle can reach past its unrotated bounds, so it's culled by the circle around it instead
+                if (angle == 0.0 ? !camera.is_visible(x, y, w, h) : !camera.is_circle_visible(x + w / 2.0, y + h / 2.0, std::sqrt(w * w + h * h) / 2.0)) {
+                    this->culled_draws++;
+                    return false;
+                }
+                if (camera.get_rotation() == 0.0) {
+                    dst = camera.get_screen_rectangle(x, y, w, h);
+                } else {
+                    const SDL_FPoint center = camera.world_to_screen(x + w / 2.0, y + h / 2.0);
+                    const int width = static_cast<int>(std::lround(w * camera.get_zoom())), height = static_cast<int>(std::lround(h * camera.get_zoom()));
+                    dst = {static_cast<int>(std::lround(center.x - width / 2.0)), static_cast<int>(std::lround(center.y - height / 2.0)), width, height};
+                }
+                // The camera turns the world clockwise on screen, which is negative in bengine's counterclockwise convention; the drawing functions negate the angle again for SDL, so textures end up turning the same way as bengine::camera_2d::world_to_screen moves their corners
+                angle -= camera.get_rotation();
+                return true;
+            }
+
+            /** Find an acquired render target by its handle
+             * \param id The handle returned by bengine::render_window::acquire_render_target
+             * \returns The render target, or NULL if there isn't one acquired under that handle
+             */
+            bengine::render_window::pooled_render_target* find_render_target(const unsigned int &id) {
+                if (id == 0) {
+                    return NULL;
+                }
+                for (std::size_t i = 0; i < this->render_targets.size(); i++) {
+                    if (this->render_targets[i].id == id) {
+                        return &this->render_targets[i];
+                    }
+                }
+                return NULL;
+            }
+            /** Target the renderer at any texture, going through bengine::render_window::target_renderer_at_window or bengine::render_window::target_renderer_at_dummy when it's one of theirs so that partial redraw clipping stays right
+             * \param texture The texture to target (NULL for the window)
+             * \returns 0 on success or a negative error code on failure
+             */
+            int retarget_renderer(SDL_Texture *texture) {
+                if (texture == this->window_target) {
+                    return this->target_renderer_at_window();
+                } else if (texture != NULL && texture == this->dummy_texture) {
+                    return this->target_renderer_at_dummy();
+                }
+
+                this->flush_batches();
+                if (this->window_target != NULL) {
+                    SDL_RenderSetClipRect(this->renderer, NULL);
+                }
+                const int output = SDL_SetRenderTarget(this->renderer, texture);
+                if (output != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to switch the rendering target to a pooled render target [bengine::render_window::retarget_renderer]";
+                    this->print_error();
+                } else {
+                    this->render_target = true;
+                    this->current_target = texture;
+                }
+                return output;
+            }
+            /** Overwrite one texture with another of the same size, then go back to whatever the renderer was targeting
+             * \param source The texture to copy
+             * \param destination The target texture to copy into
+             */
+            void copy_whole_texture(SDL_Texture *source, SDL_Texture *destination) {
+                SDL_Texture *previous_target = this->current_target;
+                if (this->retarget_renderer(destination) != 0) {
+                    return;
+                }
+                // Copying without blending overwrites the destination outright, so it doesn't need to be cleared first
+                SDL_BlendMode blend_mode;
+                SDL_GetTextureBlendMode(source, &blend_mode);
+                SDL_SetTextureBlendMode(source, SDL_BLENDMODE_NONE);
+                if (SDL_RenderCopy(this->renderer, source, NULL, NULL) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to copy a texture [bengine::render_window::copy_whole_texture]";
+                    this->print_error();
+                }
+                SDL_SetTextureBlendMode(source, blend_mode);
+                this->retarget_renderer(previous_target);
+            }
+
+            /** Run one recorded command through the regular drawing functions
+             * \param buffer The buffer that the command is in
+             * \param command The command
+             */
+            void replay_command(const bengine::command_buffer &buffer, const bengine::command_buffer::command &command) {
+                switch (command.kind) {
+                    case bengine::command_buffer::command_kind::CLEAR:
+                        this->clear_renderer(command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::PIXEL:
+                        this->draw_pixel(command.shape.x, command.shape.y, command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::LINE:
+                        this->draw_line(command.shape.x, command.shape.y, command.shape.w, command.shape.h, command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::RECTANGLE:
+                        this->draw_rectangle(command.shape.x, command.shape.y, command.shape.w, command.shape.h, command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::FILLED_RECTANGLE:
+                        this->fill_rectangle(command.shape.x, command.shape.y, command.shape.w, command.shape.h, command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::ELLIPSE:
+                        this->draw_ellipse(command.shape.x, command.shape.y, command.shape.w, command.shape.h, command.color, command.antialiased);
+                        break;
+                    case bengine::command_buffer::command_kind::FILLED_ELLIPSE:
+                        this->fill_ellipse(command.shape.x, command.shape.y, command.shape.w, command.shape.h, command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::TEXTURE:
+                        this->render_SDLTexture(command.texture, command.src, command.shape);
+                        break;
+                    case bengine::command_buffer::command_kind::ROTATED_TEXTURE:
+                        this->render_SDLTexture(command.texture, command.src, command.shape, command.angle, command.pivot, command.flip);
+                        break;
+                    case bengine::command_buffer::command_kind::TTF_TEXT:
+                        this->render_text(command.ttf_font, buffer.get_text(command), command.shape.x, command.shape.y, static_cast<Uint32>(command.shape.w), command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::FONT_TEXT:
+                        this->render_text(*command.font, buffer.get_text(command), command.shape.x, command.shape.y, command.shape.w, command.color);
+                        break;
+                    case bengine::command_buffer::command_kind::PUSH_TARGET:
+                        this->push_render_target(command.target);
+                        break;
+                    case bengine::command_buffer::command_kind::POP_TARGET:
+                        this->pop_render_target();
+                        break;
+                }
+            }
+            // \brief Replay every submitted command buffer and forget them
+            void replay_submitted() {
+                if (this->submitted_commands.empty()) {
+                    return;
+                }
+                // Swapped out first so that nothing the commands do can end up replaying them again
+                std::vector<const bengine::command_buffer*> buffers;
+                buffers.swap(this->submitted_commands);
+                this->replay(buffers);
+                buffers.clear();
+                if (this->submitted_commands.empty()) {
+                    buffers.swap(this->submitted_commands);
+                }
+            }
+
         public:
             /** bengine::render_window constructor
              * \param title The title for the window
              * \param width The width for the window (px)
              * \param height The height for the window (px)
              * \param flags SDL_WINDOW flags that modify how the window will behave as a Uint32 mask
+             * \param headless Whether to skip creating an actual window and GPU renderer and instead draw into an offscreen surface with a software renderer (doesn't need the SDL video subsystem; textures can still be loaded and everything can still be drawn, it just never shows up anywhere)
              */
-            render_window(const char* title = "window", const int &width = 1920, const int &height = 1080, const Uint32 &flags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE) {
-                if ((this->window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, flags)) == NULL) {
-                    std::cout << "Window \"" << title << "\" failed to initialize [bengine::render_window::render_window]";
-                    this->print_error();
-                }
-                if ((this->renderer = SDL_CreateRenderer(this->window, -1, SDL_RENDERER_ACCELERATED)) == NULL) {
-                    std::cout << "Window \"" << title << "\" failed to initialize its renderer [bengine::render_window::render_window]";
-                    this->print_error();
+            render_window(const char* title = "window", const int &width = 1920, const int &height = 1080, const Uint32 &flags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE, const bool &headless = false) {
+                if (headless) {
+                    this->headless_title = title;
+                    if ((this->headless_surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888)) == NULL) {
+                        std::cout << "Window \"" << title << "\" failed to initialize its offscreen surface [bengine::render_window::render_window]";
+                        this->print_error();
+                    } else if ((this->renderer = SDL_CreateSoftwareRenderer(this->headless_surface)) == NULL) {
+                        std::cout << "Window \"" << title << "\" failed to initialize its software renderer [bengine::render_window::render_window]";
+                        this->print_error();
+                    }
+                    this->rasterizer.set_target(this->headless_surface);
+                } else {
+                    if ((this->window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, flags)) == NULL) {
+                        std::cout << "Window \"" << title << "\" failed to initialize [bengine::render_window::render_window]";
+                        this->print_error();
+                    }
+                    if ((this->renderer = SDL_CreateRenderer(this->window, -1, SDL_RENDERER_ACCELERATED)) == NULL) {
+                        std::cout << "Window \"" << title << "\" failed to initialize its renderer [bengine::render_window::render_window]";
+                        this->print_error();
+                    }
                 }
 
                 this->width = width;
@@ -162,30 +906,81 @@ namespace bengine {
                 this->ratio_lock_height = this->height / gcd;
 
                 this->generate_dummy_pixel_format();
+                this->syncronize_refresh_rate();
             }
             // \brief bengine::render_window deconstructor
             ~render_window() {
+                // The cached textures, the back buffer, and the pooled render targets belong to the renderer, so they have to go first
+                this->text_textures.clear();
+                if (this->back_buffer != NULL) {
+                    SDL_DestroyTexture(this->back_buffer);
+                    this->back_buffer = NULL;
+                }
+                for (std::size_t i = 0; i < this->render_targets.size(); i++) {
+                    SDL_DestroyTexture(this->render_targets[i].texture);
+                }
+                this->render_targets.clear();
+                this->dummy_texture = nullptr;
                 SDL_DestroyRenderer(this->renderer);
                 SDL_DestroyWindow(this->window);
+                SDL_FreeSurface(this->headless_surface);
                 this->renderer = nullptr;
                 this->window = nullptr;
+                this->headless_surface = nullptr;
             }
 
-            /** Get the refresh rate of the monitor that the window was created on
-             *\returns The refresh rate of the monitor that the window was created on
+            /** Get whether the window is headless (drawing into an offscreen surface instead of an actual window) or not
+             * \returns Whether the window is headless or not
+             */
+            bool is_headless() const {
+                return this->headless_surface != NULL;
+            }
+            /** Get whether a headless window draws its primitives (pixels, lines, rectangles, and ellipses) with its own SIMD rasterizer rather than SDL's generic software renderer
+             * \returns Whether primitives are software rasterized (always false for regular windows)
+             */
+            bool is_software_rasterizing() const {
+                return this->software_rasterizing && this->is_headless();
+            }
+            /** Choose whether a headless window draws its primitives with its own SIMD rasterizer (the default) or hands them to SDL's generic software renderer; textures are always drawn by SDL, and so is anything drawn into an offscreen render target
+             * \param software_rasterizing Whether to software rasterize primitives (has no effect on regular windows)
+             */
+            void set_software_rasterizing(const bool &software_rasterizing) {
+                this->flush_batches();
+                this->software_rasterizing = software_rasterizing;
+            }
+
+            /** Get the refresh rate of the monitor that the window is on (cached; see bengine::render_window::syncronize_refresh_rate)
+             *\returns The refresh rate of the monitor that the window is on (Hz)
              */
             int get_refresh_rate() const {
+                return this->refresh_rate;
+            }
+            /** Re-fetch the refresh rate of the monitor that the window is on (done automatically on creation and whenever the window is moved)
+             * \returns 0 on success or a negative error code on failure (the previous refresh rate is kept on failure)
+             */
+            int syncronize_refresh_rate() {
+                // Headless windows aren't on any monitor, so they just keep the default
+                if (this->is_headless()) {
+                    return 0;
+                }
+
                 SDL_DisplayMode mode;
                 const int display_index = SDL_GetWindowDisplayIndex(this->window);
                 if (display_index < 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to fetch its display index [bengine::render_window::get_refresh_rate]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to fetch its display index [bengine::render_window::syncronize_refresh_rate]";
                     this->print_error();
+                    return -1;
                 }
                 if (SDL_GetDisplayMode(display_index, 0, &mode) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to fetch its display mode information [bengine::render_window::get_refresh_rate]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to fetch its display mode information [bengine::render_window::syncronize_refresh_rate]";
                     this->print_error();
+                    return -1;
+                }
+                // Some drivers report 0 when the refresh rate is unknown
+                if (mode.refresh_rate > 0) {
+                    this->refresh_rate = mode.refresh_rate;
                 }
-                return mode.refresh_rate;
+                return 0;
             }
             /** Get the SDL_WINDOW flags currently associated with the window
              * \returns The SDL_WINDOW flags currently associated with the window as a Uint32 mask
@@ -406,12 +1201,19 @@ namespace bengine {
              * \returns The window's title as a C-style string
              */
             const char* get_title() const {
+                if (this->is_headless()) {
+                    return this->headless_title.c_str();
+                }
                 return SDL_GetWindowTitle(this->window);
             }
             /** Set the window's title as a C-style string
              * \param title The window's new title as a C-style string
              */
             void set_title(const char* title) {
+                if (this->is_headless()) {
+                    this->headless_title = title;
+                    return;
+                }
                 SDL_SetWindowTitle(this->window, title);
             }
 
@@ -419,77 +1221,262 @@ namespace bengine {
              * \param color The color to make the newly blank screen as an SDL_Color
              */
             void clear_renderer(const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::BLACK)) {
+                // Anything still waiting in the batches would just get cleared away
+                this->discard_batches();
                 this->change_draw_color(color);
-                if (SDL_RenderClear(this->renderer) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to clear renderer [bengine::render_window::clear_renderer]";
+                if (this->submit_clear() != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to clear renderer [bengine::render_window::clear_renderer]";
                     this->print_error();
                 }
             }
-            // \brief Present the renderer's buffer to the window to see
+            // \brief Present the renderer's buffer to the window to see (replays any submitted command buffers and draws anything left in the batches first)
             void present_renderer() {
+                this->replay_submitted();
+                this->flush_batches();
                 SDL_RenderPresent(this->renderer);
+                this->culled_draws = 0;
             }
 
-            // \brief Syncronize the class's dimensional members with the SDL_Window to clear any potential discrepancies
-            void syncronize_dimensions() {
-                int width, height;
-                SDL_GetWindowSize(this->window, &width, &height);
-
-                this->width = width;
-                this->height = height;
-                this->width_2 = this->width / 2;
-                this->height_2 = this->height / 2;
+            /** Get whether the window only redraws the parts of itself that have been invalidated
+             * \returns Whether the window only redraws the parts of itself that have been invalidated
+             */
+            bool is_partially_redrawing() const {
+                return this->partial_redraw;
             }
-            /** Handles the general behavior that windows should have when certain events trigger (for now, just window resizing)
-             * \param event The SDL_WindowEvent to handle
+            /** Make the window start only redrawing the parts of itself that have been invalidated
+             *
+             * Frames get drawn into a persistent back buffer instead of straight to the window; bengine::render_window::begin_partial_redraw clips drawing to the bounds of the dirty rectangles and bengine::render_window::end_partial_redraw copies the whole back buffer to the window, so everything outside of the dirty rectangles stays as it was on the frame before (bengine::loop does both automatically around render())
              */
-            void handle_event(const SDL_WindowEvent &event) {
-                switch (event.event) {
-                    case SDL_WINDOWEVENT_RESIZED:
-                    case SDL_WINDOWEVENT_SIZE_CHANGED:
-                        // if (this->has_locked_ratio) {
-                        //     int width, height;
-                        //     SDL_GetWindowSize(this->window, &width, &height);
-                            
-                        //     if (std::abs(this->width - width) / this->ratio_lock_width > std::abs(this->height - height) / this->ratio_lock_height) {
-                        //         SDL_SetWindowSize(this->window, (int)(height * (double)(this->ratio_lock_width / this->ratio_lock_height)), height);
-                        //     } else {
-                        //         SDL_SetWindowSize(this->window, width, (int)(width * (double)(this->ratio_lock_height / this->ratio_lock_width)));
-                        //     }
-                        // }
-                        this->syncronize_dimensions();
-                        break;
+            void start_partial_redrawing() {
+                if (!this->partial_redraw) {
+                    this->partial_redraw = true;
+                    this->invalidate_all();
                 }
             }
-            // \brief Center the mouse within the window
-            void center_mouse() {
-                SDL_WarpMouseInWindow(this->window, this->width_2, this->height_2);
+            // \brief Make the window go back to redrawing everything every frame (destroys the back buffer)
+            void halt_partial_redrawing() {
+                this->partial_redraw = false;
+                this->dirty_rectangles.clear();
+                if (this->back_buffer != NULL) {
+                    SDL_DestroyTexture(this->back_buffer);
+                    this->back_buffer = NULL;
+                }
             }
-            /** Set the current mouse's position to wherever specified and relative to the window
-             * \param x The x-position for the mouse's new position relative to the window (px)
-             * \param y The y-position for the mouse's new position relative to the window (px)
+            /** Mark a region of the window as needing to be redrawn (does nothing when the window isn't partially redrawing)
+             * \param x x-position of the top-left corner of the region relative to the window (px)
+             * \param y y-position of the top-left corner of the region relative to the window (px)
+             * \param w Width of the region (px)
+             * \param h Height of the region (px)
              */
-            void position_mouse(const int &x, const int &y) {
-                SDL_WarpMouseInWindow(this->window, x, y);
-            }
+            void invalidate(const int &x, const int &y, const int &w, const int &h) {
+                if (!this->partial_redraw) {
+                    return;
+                }
+                SDL_Rect rectangle = {x, y, w, h};
+                if (this->stretch_graphics) {
+                    rectangle = {this->stretch_x(x), this->stretch_y(y), this->stretch_x(w), this->stretch_y(h)};
+                }
+                const SDL_Rect window_bounds = {0, 0, this->width, this->height};
+                if (SDL_IntersectRect(&rectangle, &window_bounds, &rectangle) != SDL_TRUE) {
+                    return;
+                }
 
-            /** Draw a singular pixel
-             * \param x x-position of the pixel to change relative to the window
-             * \param y y-position of the pixel to change relative to the window
-             * \param color The color to change the pixel to as an SDL_Color
+                for (std::size_t i = 0; i < this->dirty_rectangles.size(); i++) {
+                    SDL_Rect overlap;
+                    if (SDL_IntersectRect(&rectangle, &this->dirty_rectangles[i], &overlap) == SDL_TRUE && overlap.w == rectangle.w && overlap.h == rectangle.h) {
+                        return;
+                    }
+                }
+                if (this->dirty_rectangles.empty()) {
+                    this->dirty_bounds = rectangle;
+                } else {
+                    SDL_UnionRect(&this->dirty_bounds, &rectangle, &this->dirty_bounds);
+                }
+                if (this->dirty_rectangles.size() >= bengine::render_window::dirty_rectangle_limit) {
+                    this->dirty_rectangles.assign(1, this->dirty_bounds);
+                    return;
+                }
+                this->dirty_rectangles.emplace_back(rectangle);
+            }
+            /** Mark a region of the window as needing to be redrawn (does nothing when the window isn't partially redrawing)
+             * \param rectangle The region relative to the window (px for all 4 metrics)
+             */
+            void invalidate(const SDL_Rect &rectangle) {
+                this->invalidate(rectangle.x, rectangle.y, rectangle.w, rectangle.h);
+            }
+            // \brief Mark the whole window as needing to be redrawn (does nothing when the window isn't partially redrawing)
+            void invalidate_all() {
+                if (!this->partial_redraw) {
+                    return;
+                }
+                this->dirty_rectangles.assign(1, {0, 0, this->width, this->height});
+                this->dirty_bounds = this->dirty_rectangles[0];
+            }
+            /** Get whether any part of the window needs to be redrawn
+             * \returns Whether any part of the window needs to be redrawn
+             */
+            bool has_dirty_rectangles() const {
+                return !this->dirty_rectangles.empty();
+            }
+            /** Get the regions of the window that need to be redrawn (already stretched, so they're in the window's actual pixels)
+             * \returns The regions of the window that need to be redrawn
+             */
+            const std::vector<SDL_Rect>& get_dirty_rectangles() const {
+                return this->dirty_rectangles;
+            }
+            /** Get the smallest rectangle containing every region that needs to be redrawn (already stretched); partial redraws are clipped to this
+             * \returns The smallest rectangle containing every region that needs to be redrawn
+             */
+            SDL_Rect get_dirty_bounds() const {
+                return this->dirty_bounds;
+            }
+            /** Check whether something drawn in a region would be part of the current redraw, so that render() can skip anything that wouldn't
+             * \param x x-position of the top-left corner of the region relative to the window (px)
+             * \param y y-position of the top-left corner of the region relative to the window (px)
+             * \param w Width of the region (px)
+             * \param h Height of the region (px)
+             * \returns Whether the region touches a dirty rectangle (always true when the window isn't partially redrawing)
+             */
+            bool needs_redraw(const int &x, const int &y, const int &w, const int &h) const {
+                if (!this->partial_redraw) {
+                    return true;
+                }
+                SDL_Rect rectangle = {x, y, w, h};
+                if (this->stretch_graphics) {
+                    rectangle = {this->stretch_x(x), this->stretch_y(y), this->stretch_x(w), this->stretch_y(h)};
+                }
+                for (std::size_t i = 0; i < this->dirty_rectangles.size(); i++) {
+                    if (SDL_HasIntersection(&rectangle, &this->dirty_rectangles[i]) == SDL_TRUE) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            /** Start a partial redraw: target the back buffer, clip drawing to the dirty bounds, and clear just that region (everything is dirty if nothing was invalidated, or if the back buffer had to be made or resized)
+             * \param color The color to clear the dirty region to as an SDL_Color
+             * \returns Whether the partial redraw started; on failure the window should just be drawn normally
+             */
+            bool begin_partial_redraw(const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::BLACK)) {
+                if (this->back_buffer == NULL || this->back_buffer_width != this->width || this->back_buffer_height != this->height) {
+                    if (this->back_buffer != NULL) {
+                        SDL_DestroyTexture(this->back_buffer);
+                    }
+                    if ((this->back_buffer = SDL_CreateTexture(this->renderer, this->dummy_pixel_format.format, SDL_TEXTUREACCESS_TARGET, this->width, this->height)) == NULL) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to create a back buffer for partial redrawing [bengine::render_window::begin_partial_redraw]";
+                        this->print_error();
+                        return false;
+                    }
+                    this->back_buffer_width = this->width;
+                    this->back_buffer_height = this->height;
+                    this->invalidate_all();
+                }
+                if (this->dirty_rectangles.empty()) {
+                    this->invalidate_all();
+                }
+
+                this->discard_batches();
+                this->window_target = this->back_buffer;
+                if (this->target_renderer_at_window() != 0) {
+                    this->window_target = NULL;
+                    return false;
+                }
+
+                // SDL_RenderClear ignores the clip rectangle, so the dirty region gets overwritten with a fill instead
+                SDL_BlendMode previous_blend_mode = SDL_BLENDMODE_NONE;
+                SDL_GetRenderDrawBlendMode(this->renderer, &previous_blend_mode);
+                SDL_SetRenderDrawBlendMode(this->renderer, SDL_BLENDMODE_NONE);
+                this->change_draw_color(color);
+                this->submit_rectangles(&this->dirty_bounds, 1, true);
+                SDL_SetRenderDrawBlendMode(this->renderer, previous_blend_mode);
+                return true;
+            }
+            /** Finish a partial redraw: replay any submitted command buffers, draw anything left in the batches, copy the whole back buffer to the window, and forget the dirty rectangles (the result still needs to be presented)
+             */
+            void end_partial_redraw() {
+                this->replay_submitted();
+                this->flush_batches();
+                SDL_RenderSetClipRect(this->renderer, NULL);
+                this->window_target = NULL;
+                this->target_renderer_at_window();
+                if (SDL_RenderCopy(this->renderer, this->back_buffer, NULL, NULL) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to copy its back buffer [bengine::render_window::end_partial_redraw]";
+                    this->print_error();
+                }
+                this->dirty_rectangles.clear();
+            }
+
+            // \brief Syncronize the class's dimensional members with the SDL_Window to clear any potential discrepancies
+            void syncronize_dimensions() {
+                int width = this->width, height = this->height;
+                // A headless window's offscreen surface never changes size, so it always wins over whatever was requested
+                if (this->is_headless()) {
+                    width = this->headless_surface->w;
+                    height = this->headless_surface->h;
+                } else {
+                    SDL_GetWindowSize(this->window, &width, &height);
+                }
+
+                this->width = width;
+                this->height = height;
+                this->width_2 = this->width / 2;
+                this->height_2 = this->height / 2;
+            }
+            /** Handles the general behavior that windows should have when certain events trigger (for now, just window resizing and moving)
+             * \param event The SDL_WindowEvent to handle
+             */
+            void handle_event(const SDL_WindowEvent &event) {
+                switch (event.event) {
+                    case SDL_WINDOWEVENT_RESIZED:
+                    case SDL_WINDOWEVENT_SIZE_CHANGED:
+                        // if (this->has_locked_ratio) {
+                        //     int width, height;
+                        //     SDL_GetWindowSize(this->window, &width, &height);
+                            
+                        //     if (std::abs(this->width - width) / this->ratio_lock_width > std::abs(this->height - height) / this->ratio_lock_height) {
+                        //         SDL_SetWindowSize(this->window, (int)(height * (double)(this->ratio_lock_width / this->ratio_lock_height)), height);
+                        //     } else {
+                        //         SDL_SetWindowSize(this->window, width, (int)(width * (double)(this->ratio_lock_height / this->ratio_lock_width)));
+                        //     }
+                        // }
+                        this->syncronize_dimensions();
+                        break;
+                    case SDL_WINDOWEVENT_MOVED:
+                        // The window may have moved onto a monitor with a different refresh rate
+                        this->syncronize_refresh_rate();
+                        break;
+                }
+            }
+            // \brief Center the mouse within the window
+            void center_mouse() {
+                SDL_WarpMouseInWindow(this->window, this->width_2, this->height_2);
+            }
+            /** Set the current mouse's position to wherever specified and relative to the window
+             * \param x The x-position for the mouse's new position relative to the window (px)
+             * \param y The y-position for the mouse's new position relative to the window (px)
+             */
+            void position_mouse(const int &x, const int &y) {
+                SDL_WarpMouseInWindow(this->window, x, y);
+            }
+
+            /** Draw a singular pixel
+             * \param x x-position of the pixel to change relative to the window
+             * \param y y-position of the pixel to change relative to the window
+             * \param color The color to change the pixel to as an SDL_Color
              */
             void draw_pixel(const int &x, const int &y, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
                 this->change_draw_color(color);
 
                 if (this->stretch_graphics) {
-                    if (SDL_RenderDrawPoint(this->renderer, this->stretch_x(x), this->stretch_y(y)) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a pixel [bengine::render_window::draw_pixel]";
+                    const SDL_Point stretched = {this->stretch_x(x), this->stretch_y(y)};
+                    if (this->submit_points(&stretched, 1) != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to draw a pixel [bengine::render_window::draw_pixel]";
                         this->print_error();
                     }
                     return;
                 }
-                if (SDL_RenderDrawPoint(this->renderer, x, y) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a pixel [bengine::render_window::draw_pixel]";
+                const SDL_Point point = {x, y};
+                if (this->submit_points(&point, 1) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to draw a pixel [bengine::render_window::draw_pixel]";
                     this->print_error();
                 }
             }
@@ -517,8 +1504,8 @@ namespace bengine {
                     }
 
                     this->change_draw_color(color);
-                    if (SDL_RenderDrawLine(this->renderer, this->stretch_x(x1), this->stretch_y(y1), this->stretch_x(x2), this->stretch_y(y2)) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a line [bengine::render_window::draw_line]";
+                    if (this->submit_line(this->stretch_x(x1), this->stretch_y(y1), this->stretch_x(x2), this->stretch_y(y2)) != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to draw a line [bengine::render_window::draw_line]";
                         this->print_error();
                     }
                     return;
@@ -533,8 +1520,8 @@ namespace bengine {
                 }
 
                 this->change_draw_color(color);
-                if (SDL_RenderDrawLine(this->renderer, x1, y1, x2, y2) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a line [bengine::render_window::draw_line]";
+                if (this->submit_line(x1, y1, x2, y2) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to draw a line [bengine::render_window::draw_line]";
                     this->print_error();
                 }
             }
@@ -551,15 +1538,15 @@ namespace bengine {
                 
                 if (this->stretch_graphics) {
                     const SDL_Rect dst = {x, y, w, h};
-                    if (SDL_RenderDrawRect(this->renderer, &dst) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a rectangle [bengine::render_window::draw_rectangle]";
+                    if (this->submit_rectangles(&dst, 1, false) != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to draw a rectangle [bengine::render_window::draw_rectangle]";
                         this->print_error();
                     }
                     return;
                 }
                 const SDL_Rect dst = {this->stretch_x(x), this->stretch_y(y), this->stretch_x(w), this->stretch_y(h)};
-                if (SDL_RenderDrawRect(this->renderer, &dst) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a rectangle [bengine::render_window::draw_rectangle]";
+                if (this->submit_rectangles(&dst, 1, false) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to draw a rectangle [bengine::render_window::draw_rectangle]";
                     this->print_error();
                 }
             }
@@ -607,8 +1594,8 @@ namespace bengine {
                     }
                 }
 
-                if (SDL_RenderFillRect(this->renderer, &rect[0]) != 0 || SDL_RenderFillRect(this->renderer, &rect[1]) != 0 || SDL_RenderFillRect(this->renderer, &rect[2]) != 0 || SDL_RenderFillRect(this->renderer, &rect[3]) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to draw a thick rectangle [bengine::render_window::draw_thick_rectangle]";
+                if (this->submit_rectangles(rect, 4, true) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to draw a thick rectangle [bengine::render_window::draw_thick_rectangle]";
                     this->print_error();
                 }
             }
@@ -624,80 +1611,487 @@ namespace bengine {
 
                 if (this->stretch_graphics) {
                     const SDL_Rect dst = {x, y, w, h};
-                    if (SDL_RenderFillRect(this->renderer, &dst) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to fill a rectangle [bengine::render_window::fill_rectangle]";
+                    if (this->submit_rectangles(&dst, 1, true) != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to fill a rectangle [bengine::render_window::fill_rectangle]";
                         this->print_error();
                     }
                     return;
                 }
                 const SDL_Rect dst = {this->stretch_x(x), this->stretch_y(y), this->stretch_x(w), this->stretch_y(h)};
-                if (SDL_RenderFillRect(this->renderer, &dst) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to fill a rectangle [bengine::render_window::fill_rectangle]";
+                if (this->submit_rectangles(&dst, 1, true) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to fill a rectangle [bengine::render_window::fill_rectangle]";
+                    this->print_error();
+                }
+            }
+            /** Draw an ellipse (not filled, will only draw the perimeter); the outline is built from a span table that is cached for each size, and goes out in a single SDL call
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx Horizontal radius of the ellipse (px)
+             * \param ry Vertical radius of the ellipse (px)
+             * \param color The color to draw the ellipse with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels (always drawn with SDL_BLENDMODE_BLEND)
+             */
+            void draw_ellipse(const int &x, const int &y, const int &rx, const int &ry, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const bool &antialiased = false) {
+                const SDL_Rect shape = this->get_ellipse_shape(x, y, rx, ry);
+                int result = 0;
+                if (antialiased && shape.w > 0 && shape.h > 0) {
+                    this->batch_vertices.clear();
+                    this->batch_indices.clear();
+                    this->append_antialiased_ellipse(shape, color);
+                    result = this->render_blended_geometry();
+                } else {
+                    this->batch_points.clear();
+                    this->append_ellipse_outline(shape, this->batch_points);
+                    this->change_draw_color(color);
+                    result = this->submit_points(this->batch_points.data(), static_cast<int>(this->batch_points.size()));
+                }
+                if (result != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to draw an ellipse [bengine::render_window::draw_ellipse]";
                     this->print_error();
                 }
             }
-            /** Draw a circle (not filled, will only draw the perimeter at the set thickness; DOES NOT GET STRETCHED)
+            /** Fill an ellipse; the spans are cached for each size and go out in a single SDL_RenderFillRects call
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx Horizontal radius of the ellipse (px)
+             * \param ry Vertical radius of the ellipse (px)
+             * \param color The color to fill the ellipse with as an SDL_Color
+             */
+            void fill_ellipse(const int &x, const int &y, const int &rx, const int &ry, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                this->batch_rectangles.clear();
+                this->append_ellipse_spans(this->get_ellipse_shape(x, y, rx, ry), this->batch_rectangles);
+                this->change_draw_color(color);
+                if (this->submit_rectangles(this->batch_rectangles.data(), static_cast<int>(this->batch_rectangles.size()), true) != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to fill an ellipse [bengine::render_window::fill_ellipse]";
+                    this->print_error();
+                }
+            }
+            /** Draw a circle (not filled, will only draw the perimeter; see bengine::render_window::draw_ellipse)
              * \param x x-position of the center of the circle relative to the window (px)
              * \param y y-position of the center of the circle relative to the window (px)
              * \param r Radius of the circle (px)
              * \param color The color to draw the circle with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels (always drawn with SDL_BLENDMODE_BLEND)
              */
-            void draw_circle(const int &x, const int &y, const int &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
-                SDL_SetRenderDrawColor(this->renderer, color.r, color.g, color.b, color.a);
-                const int diameter = r * 2;
-                int ox = r - 1;
-                int oy = 0;
-                int tx = 1;
-                int ty = 1;
-                int error = tx - diameter;
-                while (ox >= oy) {
-                    SDL_RenderDrawPoint(this->renderer, x + ox, y - oy);
-                    SDL_RenderDrawPoint(this->renderer, x + ox, y + oy);
-                    SDL_RenderDrawPoint(this->renderer, x - ox, y - oy);
-                    SDL_RenderDrawPoint(this->renderer, x - ox, y + oy);
-                    SDL_RenderDrawPoint(this->renderer, x + oy, y - ox);
-                    SDL_RenderDrawPoint(this->renderer, x + oy, y + ox);
-                    SDL_RenderDrawPoint(this->renderer, x - oy, y - ox);
-                    SDL_RenderDrawPoint(this->renderer, x - oy, y + ox);
-                    if (error <= 0) {
-                        oy++;
-                        error += ty;
-                        ty += 2;
-                    } else if (error > 0) {
-                        ox--;
-                        tx += 2;
-                        error += tx - diameter;
-                    }
-                }
-            }
-            /** Fill a circle (DOES NOT GET STRETCHED)
+            void draw_circle(const int &x, const int &y, const int &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const bool &antialiased = false) {
+                this->draw_ellipse(x, y, r, r, color, antialiased);
+            }
+            /** Fill a circle (see bengine::render_window::fill_ellipse)
              * \param x x-position of the center of the circle relative to the window (px)
              * \param y y-position of the center of the circle relative to the window (px)
              * \param r Radius of the circle (px)
              * \param color The color to fill the circle with as an SDL_Color
              */
             void fill_circle(const int &x, const int &y, const int &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
-                SDL_SetRenderDrawColor(this->renderer, color.r, color.g, color.b, color.a);
-                int ox = 0;
-                int oy = r;
-                int error = r - 1;
-                while (oy >= ox) {
-                    SDL_RenderDrawLine(this->renderer, x - oy, y + ox, x + oy, y + ox);
-                    SDL_RenderDrawLine(this->renderer, x - ox, y + oy, x + ox, y + oy);
-                    SDL_RenderDrawLine(this->renderer, x - ox, y - oy, x + ox, y - oy);
-                    SDL_RenderDrawLine(this->renderer, x - oy, y - ox, x + oy, y - ox);
-                    if (error >= ox * 2) {
-                        error -= ox * 2 + 1;
-                        ox++;
-                    } else if (error < 2 * (r - oy)) {
-                        error += oy * 2 - 1;
-                        oy--;
+                this->fill_ellipse(x, y, r, r, color);
+            }
+
+            /** Draw a singular pixel at a point in the world (see bengine::render_window::draw_pixel)
+             * \param camera The camera to look through
+             * \param x x-position of the pixel (world units)
+             * \param y y-position of the pixel (world units)
+             * \param color The color to change the pixel to as an SDL_Color
+             */
+            void draw_pixel(const bengine::camera_2d &camera, const double &x, const double &y, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                if (!camera.is_visible(x, y)) {
+                    this->culled_draws++;
+                    return;
+                }
+                const SDL_FPoint point = camera.world_to_screen(x, y);
+                this->draw_pixel(static_cast<int>(point.x), static_cast<int>(point.y), color);
+            }
+            /** Draw a line between two points in the world (see bengine::render_window::draw_line)
+             * \param camera The camera to look through
+             * \param x1 x-position of the starting point (world units)
+             * \param y1 y-position of the starting point (world units)
+             * \param x2 x-position of the ending point (world units)
+             * \param y2 y-position of the ending point (world units)
+             * \param color The color to draw the line with as an SDL_Color
+             */
+            void draw_line(const bengine::camera_2d &camera, const double &x1, const double &y1, const double &x2, const double &y2, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                if (!camera.is_visible(x1, y1, x2 - x1, y2 - y1)) {
+                    this->culled_draws++;
+                    return;
+                }
+                const SDL_FPoint start = camera.world_to_screen(x1, y1);
+                const SDL_FPoint end = camera.world_to_screen(x2, y2);
+                this->draw_line(static_cast<int>(std::lround(start.x)), static_cast<int>(std::lround(start.y)), static_cast<int>(std::lround(end.x)), static_cast<int>(std::lround(end.y)), color);
+            }
+            /** Draw a rectangle in the world (not filled, will only draw the perimeter; see bengine::render_window::draw_rectangle)
+             * \param camera The camera to look through
+             * \param x x-position of the top-left corner (world units)
+             * \param y y-position of the top-left corner (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \param color The color to draw the rectangle with as an SDL_Color
+             */
+            void draw_rectangle(const bengine::camera_2d &camera, const double &x, const double &y, const double &w, const double &h, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                SDL_Rect dst;
+                double angle = 0.0;
+                if (!this->place_in_view(camera, x, y, w, h, dst, angle)) {
+                    return;
+                }
+                if (angle == 0.0) {
+                    this->draw_rectangle(dst.x, dst.y, dst.w, dst.h, color);
+                    return;
+                }
+                // A rotated outline is just its 4 edges
+                const SDL_FPoint corners[4] = {camera.world_to_screen(x, y), camera.world_to_screen(x + w, y), camera.world_to_screen(x + w, y + h), camera.world_to_screen(x, y + h)};
+                for (unsigned char i = 0; i < 4; i++) {
+                    const SDL_FPoint &start = corners[i], &end = corners[(i + 1) % 4];
+                    this->draw_line(static_cast<int>(std::lround(start.x)), static_cast<int>(std::lround(start.y)), static_cast<int>(std::lround(end.x)), static_cast<int>(std::lround(end.y)), color);
+                }
+            }
+            /** Fill a rectangle in the world (see bengine::render_window::fill_rectangle)
+             * \param camera The camera to look through
+             * \param x x-position of the top-left corner (world units)
+             * \param y y-position of the top-left corner (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \param color The color to fill the rectangle with as an SDL_Color
+             */
+            void fill_rectangle(const bengine::camera_2d &camera, const double &x, const double &y, const double &w, const double &h, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                SDL_Rect dst;
+                double angle = 0.0;
+                if (!this->place_in_view(camera, x, y, w, h, dst, angle)) {
+                    return;
+                }
+                if (angle == 0.0) {
+                    this->fill_rectangle(dst.x, dst.y, dst.w, dst.h, color);
+                    return;
+                }
+
+                // A rotated fill is a single colored quad, drawn with the renderer's draw blend mode like any other fill (and stretched the same way bengine::render_window::fill_rectangle stretches)
+                this->change_draw_color(color);
+                const SDL_FPoint corners[4] = {camera.world_to_screen(x, y), camera.world_to_screen(x + w, y), camera.world_to_screen(x + w, y + h), camera.world_to_screen(x, y + h)};
+                this->batch_vertices.clear();
+                this->batch_indices.clear();
+                for (unsigned char i = 0; i < 4; i++) {
+                    SDL_FPoint position = corners[i];
+                    if (!this->stretch_graphics) {
+                        position.x *= static_cast<float>(this->x_stretch_factor);
+                        position.y *= static_cast<float>(this->y_stretch_factor);
+                    }
+                    this->batch_vertices.push_back({position, color, {0.0f, 0.0f}});
+                }
+                const int indices[6] = {0, 1, 2, 0, 2, 3};
+                this->batch_indices.insert(this->batch_indices.end(), indices, indices + 6);
+                if (this->submit_quads() != 0) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to fill a rectangle [bengine::render_window::fill_rectangle]";
+                    this->print_error();
+                }
+            }
+            /** Draw a circle in the world (not filled, will only draw the perimeter; see bengine::render_window::draw_ellipse)
+             * \param camera The camera to look through
+             * \param x x-position of the center of the circle (world units)
+             * \param y y-position of the center of the circle (world units)
+             * \param r Radius of the circle (world units)
+             * \param color The color to draw the circle with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels (always drawn with SDL_BLENDMODE_BLEND)
+             */
+            void draw_circle(const bengine::camera_2d &camera, const double &x, const double &y, const double &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const bool &antialiased = false) {
+                if (!camera.is_circle_visible(x, y, r)) {
+                    this->culled_draws++;
+                    return;
+                }
+                const SDL_FPoint center = camera.world_to_screen(x, y);
+                this->draw_circle(static_cast<int>(std::lround(center.x)), static_cast<int>(std::lround(center.y)), static_cast<int>(std::lround(std::abs(r) * camera.get_zoom())), color, antialiased);
+            }
+            /** Fill a circle in the world (see bengine::render_window::fill_ellipse)
+             * \param camera The camera to look through
+             * \param x x-position of the center of the circle (world units)
+             * \param y y-position of the center of the circle (world units)
+             * \param r Radius of the circle (world units)
+             * \param color The color to fill the circle with as an SDL_Color
+             */
+            void fill_circle(const bengine::camera_2d &camera, const double &x, const double &y, const double &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                if (!camera.is_circle_visible(x, y, r)) {
+                    this->culled_draws++;
+                    return;
+                }
+                const SDL_FPoint center = camera.world_to_screen(x, y);
+                this->fill_circle(static_cast<int>(std::lround(center.x)), static_cast<int>(std::lround(center.y)), static_cast<int>(std::lround(std::abs(r) * camera.get_zoom())), color);
+            }
+
+            /** Add a pixel to the primitive batch instead of drawing it right away; batched primitives are grouped by layer and color so that each group is drawn with a single SDL call when the batch is flushed
+             * \param x x-position of the pixel relative to the window (px)
+             * \param y y-position of the pixel relative to the window (px)
+             * \param color The color to draw the pixel with as an SDL_Color
+             * \param layer The layer to draw the pixel on (lower layers are drawn first)
+             */
+            void batch_pixel(const int &x, const int &y, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                if (this->stretch_graphics) {
+                    this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::LINE, color, {this->stretch_x(x), this->stretch_y(y), this->stretch_x(x), this->stretch_y(y)}});
+                    return;
+                }
+                this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::LINE, color, {x, y, x, y}});
+            }
+            /** Add a line to the primitive batch (see bengine::render_window::batch_pixel); totally horizontal/vertical lines become 1px wide filled rectangles and every other line is broken down into its pixels when the batch is flushed, so any number of lines cost a single SDL call per color
+             * \param x1 x-position of the starting point relative to the window (px)
+             * \param y1 y-position of the starting point relative to the window (px)
+             * \param x2 x-position of the ending point relative to the window (px)
+             * \param y2 y-position of the ending point relative to the window (px)
+             * \param color The color to draw the line with as an SDL_Color
+             * \param layer The layer to draw the line on (lower layers are drawn first)
+             */
+            void batch_line(const int &x1, const int &y1, const int &x2, const int &y2, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                int sx1 = x1, sy1 = y1, sx2 = x2, sy2 = y2;
+                if (this->stretch_graphics) {
+                    sx1 = this->stretch_x(x1);
+                    sy1 = this->stretch_y(y1);
+                    sx2 = this->stretch_x(x2);
+                    sy2 = this->stretch_y(y2);
+                }
+
+                if ((sx1 == sx2) != (sy1 == sy2)) {
+                    this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::FILLED_RECTANGLE, color, {std::min(sx1, sx2), std::min(sy1, sy2), std::abs(sx2 - sx1) + 1, std::abs(sy2 - sy1) + 1}});
+                    return;
+                }
+                this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::LINE, color, {sx1, sy1, sx2, sy2}});
+            }
+            /** Add a rectangle to the primitive batch (not filled, will only draw the perimeter; see bengine::render_window::batch_pixel)
+             * \param x x-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param y y-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param w Width of the rectangle (px) (can be negative, thereby making the "x" parameter reference the right side of the rectangle)
+             * \param h Height of the rectangle (px) (can be negative, thereby making the "y" parameter reference the bottom side of the rectangle)
+             * \param color The color to draw the rectangle with as an SDL_Color
+             * \param layer The layer to draw the rectangle on (lower layers are drawn first)
+             */
+            void batch_rectangle(const int &x, const int &y, const int &w, const int &h, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                // Rectangles follow bengine::render_window::fill_rectangle and bengine::render_window::draw_rectangle, which pass their coordinates through untouched while stretch_graphics is on
+                if (this->stretch_graphics) {
+                    this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::RECTANGLE, color, {x, y, w, h}});
+                    return;
+                }
+                this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::RECTANGLE, color, {this->stretch_x(x), this->stretch_y(y), this->stretch_x(w), this->stretch_y(h)}});
+            }
+            /** Add a filled rectangle to the primitive batch (see bengine::render_window::batch_pixel); filled rectangles in the same layer keep their order even when their colors differ
+             * \param x x-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param y y-position of the top-left corner relative to the window (px) (assuming positive width and height)
+             * \param w Width of the rectangle (px) (can be negative, thereby making the "x" parameter reference the right side of the rectangle)
+             * \param h Height of the rectangle (px) (can be negative, thereby making the "y" parameter reference the bottom side of the rectangle)
+             * \param color The color to fill the rectangle with as an SDL_Color
+             * \param layer The layer to draw the rectangle on (lower layers are drawn first)
+             */
+            void batch_filled_rectangle(const int &x, const int &y, const int &w, const int &h, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                // Rectangles follow bengine::render_window::fill_rectangle and bengine::render_window::draw_rectangle, which pass their coordinates through untouched while stretch_graphics is on
+                if (this->stretch_graphics) {
+                    this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::FILLED_RECTANGLE, color, {x, y, w, h}});
+                    return;
+                }
+                this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::FILLED_RECTANGLE, color, {this->stretch_x(x), this->stretch_y(y), this->stretch_x(w), this->stretch_y(h)}});
+            }
+
+            /** Add an ellipse to the primitive batch (not filled, will only draw the perimeter; see bengine::render_window::batch_pixel)
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx Horizontal radius of the ellipse (px)
+             * \param ry Vertical radius of the ellipse (px)
+             * \param color The color to draw the ellipse with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels (always drawn with SDL_BLENDMODE_BLEND)
+             * \param layer The layer to draw the ellipse on (lower layers are drawn first)
+             */
+            void batch_ellipse(const int &x, const int &y, const int &rx, const int &ry, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const bool &antialiased = false, const int &layer = 0) {
+                const SDL_Rect shape = this->get_ellipse_shape(x, y, rx, ry);
+                const bool smooth = antialiased && shape.w > 0 && shape.h > 0;
+                this->primitive_batch.push_back({layer, smooth ? bengine::render_window::primitive_kind::ANTIALIASED_ELLIPSE : bengine::render_window::primitive_kind::ELLIPSE, color, shape});
+            }
+            /** Add a filled ellipse to the primitive batch (see bengine::render_window::batch_pixel); filled ellipses keep their order with filled rectangles in the same layer
+             * \param x x-position of the center of the ellipse relative to the window (px)
+             * \param y y-position of the center of the ellipse relative to the window (px)
+             * \param rx Horizontal radius of the ellipse (px)
+             * \param ry Vertical radius of the ellipse (px)
+             * \param color The color to fill the ellipse with as an SDL_Color
+             * \param layer The layer to draw the ellipse on (lower layers are drawn first)
+             */
+            void batch_filled_ellipse(const int &x, const int &y, const int &rx, const int &ry, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                this->primitive_batch.push_back({layer, bengine::render_window::primitive_kind::FILLED_ELLIPSE, color, this->get_ellipse_shape(x, y, rx, ry)});
+            }
+            /** Add a circle to the primitive batch (not filled, will only draw the perimeter; see bengine::render_window::batch_ellipse)
+             * \param x x-position of the center of the circle relative to the window (px)
+             * \param y y-position of the center of the circle relative to the window (px)
+             * \param r Radius of the circle (px)
+             * \param color The color to draw the circle with as an SDL_Color
+             * \param antialiased Whether to smooth the outline by blending its edge pixels (always drawn with SDL_BLENDMODE_BLEND)
+             * \param layer The layer to draw the circle on (lower layers are drawn first)
+             */
+            void batch_circle(const int &x, const int &y, const int &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const bool &antialiased = false, const int &layer = 0) {
+                this->batch_ellipse(x, y, r, r, color, antialiased, layer);
+            }
+            /** Add a filled circle to the primitive batch (see bengine::render_window::batch_filled_ellipse)
+             * \param x x-position of the center of the circle relative to the window (px)
+             * \param y y-position of the center of the circle relative to the window (px)
+             * \param r Radius of the circle (px)
+             * \param color The color to fill the circle with as an SDL_Color
+             * \param layer The layer to draw the circle on (lower layers are drawn first)
+             */
+            void batch_filled_circle(const int &x, const int &y, const int &r, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                this->batch_filled_ellipse(x, y, r, r, color, layer);
+            }
+
+            /** Draw everything in the primitive batch (done automatically when presenting or switching render targets, before the sprite batch)
+             *
+             * Within a layer, filled rectangles/ellipses are drawn first, then rectangle outlines, then pixels/lines/ellipse outlines, then anti-aliased outlines
+             *
+             * Fills keep their order and go out in one SDL_RenderFillRects call if they share a color or one colored SDL_RenderGeometry call if they don't; anti-aliased outlines keep their order and go out in one blended SDL_RenderGeometry call; everything else is drawn with one SDL call per color in whatever order the colors sort into
+             *
+             * \returns 0 on success or a negative error code if anything failed to draw
+             */
+            int flush_primitive_batch() {
+                this->primitive_batch_draw_calls = 0;
+                if (this->primitive_batch.empty()) {
+                    return 0;
+                }
+
+                this->primitive_batch_order.resize(this->primitive_batch.size());
+                for (std::size_t i = 0; i < this->primitive_batch_order.size(); i++) {
+                    this->primitive_batch_order[i] = i;
+                }
+                const std::vector<bengine::render_window::batched_primitive> &primitives = this->primitive_batch;
+                std::stable_sort(this->primitive_batch_order.begin(), this->primitive_batch_order.end(), [&primitives](const std::size_t &a, const std::size_t &b) {
+                    if (primitives[a].layer != primitives[b].layer) {
+                        return primitives[a].layer < primitives[b].layer;
+                    }
+                    const Uint8 stage = bengine::render_window::get_draw_stage(primitives[a].kind);
+                    if (stage != bengine::render_window::get_draw_stage(primitives[b].kind)) {
+                        return stage < bengine::render_window::get_draw_stage(primitives[b].kind);
+                    }
+                    // Fills and blended outlines can overlap each other so they keep the order they were batched in
+                    if (stage == 0 || stage == 3) {
+                        return false;
+                    }
+                    return bengine::render_window::pack_color(primitives[a].color) < bengine::render_window::pack_color(primitives[b].color);
+                });
+
+                int output = 0;
+                std::size_t run_start = 0;
+                while (run_start < this->primitive_batch_order.size()) {
+                    const bengine::render_window::batched_primitive &first = primitives[this->primitive_batch_order[run_start]];
+                    const Uint32 first_color = bengine::render_window::pack_color(first.color);
+                    const Uint8 stage = bengine::render_window::get_draw_stage(first.kind);
+                    bool single_color = true;
+                    std::size_t run_end = run_start;
+                    while (run_end < this->primitive_batch_order.size()) {
+                        const bengine::render_window::batched_primitive &primitive = primitives[this->primitive_batch_order[run_end]];
+                        if (primitive.layer != first.layer || bengine::render_window::get_draw_stage(primitive.kind) != stage) {
+                            break;
+                        }
+                        if (bengine::render_window::pack_color(primitive.color) != first_color) {
+                            // Fills and blended outlines of every color in the layer make up one run; everything else gets a run per color
+                            if (stage == 1 || stage == 2) {
+                                break;
+                            }
+                            single_color = false;
+                        }
+                        run_end++;
+                    }
+
+                    int result = 0;
+                    if (stage == 2) {
+                        this->batch_points.clear();
+                        for (std::size_t i = run_start; i < run_end; i++) {
+                            const bengine::render_window::batched_primitive &primitive = primitives[this->primitive_batch_order[i]];
+                            if (primitive.kind == bengine::render_window::primitive_kind::ELLIPSE) {
+                                this->append_ellipse_outline(primitive.shape, this->batch_points);
+                            } else {
+                                bengine::render_window::rasterize_line(primitive.shape, this->batch_points);
+                            }
+                        }
+                        this->change_draw_color(first.color);
+                        result = this->submit_points(this->batch_points.data(), static_cast<int>(this->batch_points.size()));
+                    } else if (stage == 3) {
+                        this->batch_vertices.clear();
+                        this->batch_indices.clear();
+                        for (std::size_t i = run_start; i < run_end; i++) {
+                            this->append_antialiased_ellipse(primitives[this->primitive_batch_order[i]].shape, primitives[this->primitive_batch_order[i]].color);
+                        }
+                        result = this->render_blended_geometry();
+                    } else if (single_color) {
+                        this->batch_rectangles.clear();
+                        for (std::size_t i = run_start; i < run_end; i++) {
+                            const bengine::render_window::batched_primitive &primitive = primitives[this->primitive_batch_order[i]];
+                            if (primitive.kind == bengine::render_window::primitive_kind::FILLED_ELLIPSE) {
+                                this->append_ellipse_spans(primitive.shape, this->batch_rectangles);
+                            } else {
+                                this->batch_rectangles.emplace_back(primitive.shape);
+                            }
+                        }
+                        this->change_draw_color(first.color);
+                        if (stage == 0) {
+                            result = this->submit_rectangles(this->batch_rectangles.data(), static_cast<int>(this->batch_rectangles.size()), true);
+                        } else {
+                            result = this->submit_rectangles(this->batch_rectangles.data(), static_cast<int>(this->batch_rectangles.size()), false);
+                        }
                     } else {
-                        error += 2 * (oy - ox - 1);
-                        oy--;
-                        ox++;
+                        // Untextured geometry is drawn with the renderer's draw blend mode, the same as SDL_RenderFillRects
+                        this->batch_vertices.clear();
+                        this->batch_indices.clear();
+                        for (std::size_t i = run_start; i < run_end; i++) {
+                            const bengine::render_window::batched_primitive &primitive = primitives[this->primitive_batch_order[i]];
+                            this->batch_rectangles.clear();
+                            if (primitive.kind == bengine::render_window::primitive_kind::FILLED_ELLIPSE) {
+                                this->append_ellipse_spans(primitive.shape, this->batch_rectangles);
+                            } else {
+                                this->batch_rectangles.emplace_back(primitive.shape);
+                            }
+                            for (std::size_t j = 0; j < this->batch_rectangles.size(); j++) {
+                                const SDL_Rect &rectangle = this->batch_rectangles[j];
+                                const float left = static_cast<float>(rectangle.x);
+                                const float top = static_cast<float>(rectangle.y);
+                                const float right = static_cast<float>(rectangle.x + rectangle.w);
+                                const float bottom = static_cast<float>(rectangle.y + rectangle.h);
+                                const int base = static_cast<int>(this->batch_vertices.size());
+                                this->batch_vertices.push_back({{left, top}, primitive.color, {0.0f, 0.0f}});
+                                this->batch_vertices.push_back({{right, top}, primitive.color, {0.0f, 0.0f}});
+                                this->batch_vertices.push_back({{right, bottom}, primitive.color, {0.0f, 0.0f}});
+                                this->batch_vertices.push_back({{left, bottom}, primitive.color, {0.0f, 0.0f}});
+                                const int indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+                                this->batch_indices.insert(this->batch_indices.end(), indices, indices + 6);
+                            }
+                        }
+                        result = this->submit_quads();
                     }
+                    if (result != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to draw a group of batched primitives [bengine::render_window::flush_primitive_batch]";
+                        this->print_error();
+                        output = -1;
+                    }
+                    this->primitive_batch_draw_calls++;
+
+                    run_start = run_end;
                 }
+
+                this->primitive_batch.clear();
+                return output;
+            }
+            // \brief Throw away everything in the primitive batch without drawing it
+            void discard_primitive_batch() {
+                this->primitive_batch.clear();
+            }
+            /** Get how many primitives are waiting in the primitive batch
+             * \returns How many primitives are waiting in the primitive batch
+             */
+            std::size_t get_primitive_batch_size() const {
+                return this->primitive_batch.size();
+            }
+            /** Get how many SDL draw calls the most recent primitive batch flush took
+             * \returns How many SDL draw calls the most recent primitive batch flush took
+             */
+            unsigned int get_primitive_batch_draw_calls() const {
+                return this->primitive_batch_draw_calls;
+            }
+            /** Draw everything in the primitive batch and then everything in the sprite batch
+             * \returns 0 on success or a negative error code if anything failed to draw
+             */
+            int flush_batches() {
+                const int primitive_output = this->flush_primitive_batch();
+                const int sprite_output = this->flush_sprite_batch();
+                return primitive_output != 0 ? primitive_output : sprite_output;
+            }
+            // \brief Throw away everything in the primitive batch and the sprite batch without drawing any of it
+            void discard_batches() {
+                this->discard_primitive_batch();
+                this->discard_sprite_batch();
             }
 
             /** Load an SDL_Texture using the window's renderer
@@ -707,11 +2101,29 @@ namespace bengine {
             SDL_Texture *load_texture(const char* filepath) {
                 SDL_Texture *output = NULL;
                 if ((output = IMG_LoadTexture(this->renderer, filepath)) == NULL) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to load texture [bengine::render_window::load_texture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to load texture [bengine::render_window::load_texture]";
                     this->print_error();
                 }
                 return output;
             }
+            /** Turn images that a texture loader has finished decoding into textures, spending at most the loader's upload budget on it (bengine::loop does this every frame for its own loader)
+             * \param loader The loader to upload from
+             * \returns How many textures became ready
+             */
+            std::size_t upload_textures(bengine::texture_loader &loader) {
+                return loader.upload(this->renderer);
+            }
+            /** Pack every image that's been added to a texture atlas since it was last built (the atlas's pages belong to this window's renderer from then on)
+             * \param atlas The atlas to build
+             * \returns Whether every image was packed
+             */
+            bool build_texture_atlas(bengine::texture_atlas &atlas) {
+                if (!atlas.build(this->renderer)) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to pack every image into a texture atlas [bengine::render_window::build_texture_atlas]\n";
+                    return false;
+                }
+                return true;
+            }
 
             /** Get the pixelformat that the window's dummy texture uses
              * \returns The pixelformat that the window's dummy texture uses
@@ -723,7 +2135,7 @@ namespace bengine {
             void generate_dummy_pixel_format() {
                 SDL_RendererInfo info;
                 if (SDL_GetRendererInfo(this->renderer, &info) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to get a valid pixel format [bengine::render_window::generate_dummy_pixel_format]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to get a valid pixel format [bengine::render_window::generate_dummy_pixel_format]";
                     this->print_error();
                     this->dummy_pixel_format.format = SDL_PIXELFORMAT_UNKNOWN;
                 } else {
@@ -731,7 +2143,7 @@ namespace bengine {
                 }
             }
 
-            /** Initialize the dummy texture for the ability to render to textures rather than just the window
+            /** Initialize the dummy texture for the ability to render to textures rather than just the window (the dummy texture comes out of the render target pool, so re-initializing it at a size it's had before doesn't make a new texture)
              * \param width The width of the dummy texture (px)
              * \param height The height of the dummy texture (px)
              */
@@ -739,17 +2151,21 @@ namespace bengine {
                 if (this->dummy_pixel_format.format == SDL_PIXELFORMAT_UNKNOWN) {
                     this->generate_dummy_pixel_format();
                 }
-                this->dummy_texture = SDL_CreateTexture(this->renderer, this->dummy_pixel_format.format, SDL_TEXTUREACCESS_TARGET, width, height);
+                SDL_Texture *previous_dummy = this->dummy_texture;
+                const bool targeting_dummy = this->render_target && this->current_target == previous_dummy;
+
+                this->release_render_target(this->dummy_target);
+                this->dummy_target = this->acquire_render_target(width, height, this->dummy_pixel_format.format, false);
+                bengine::render_window::pooled_render_target *target = this->find_render_target(this->dummy_target);
+                this->dummy_texture = target == NULL ? NULL : target->texture;
                 if (this->dummy_texture == NULL) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to create dummy texture [bengine::render_window::initialize_dummy]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to create dummy texture [bengine::render_window::initialize_dummy]";
                     this->print_error();
                     return -1;
                 }
-                // Re-initializing the dummy texture requires the renderer to be re-targeted
-                if (this->render_target) {
+                // Re-initializing the dummy texture requires the renderer to be re-targeted if it was targeting the old one
+                if (targeting_dummy) {
                     this->target_renderer_at_dummy();
-                } else {
-                    this->target_renderer_at_window();
                 }
                 return 0;
             }
@@ -757,54 +2173,292 @@ namespace bengine {
              * \returns 0 on success or a negative error code on failure
              */
             int target_renderer_at_dummy() {
+                this->flush_batches();
+                // Textures share their clip rectangle in SDL, so a partial redraw's clipping is lifted while drawing to the dummy texture
+                if (this->window_target != NULL) {
+                    SDL_RenderSetClipRect(this->renderer, NULL);
+                }
                 const int output = SDL_SetRenderTarget(this->renderer, this->dummy_texture);
                 if (output != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to switch the rendering target to the dummy texture [bengine::render_window::target_renderer_at_dummy]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to switch the rendering target to the dummy texture [bengine::render_window::target_renderer_at_dummy]";
                     this->print_error();
                 } else {
                     this->render_target = true;
+                    this->current_target = this->dummy_texture;
                 }
                 return output;
             }
-            /** Target the renderer at the window
+            /** Target the renderer at the window (or at the back buffer during a partial redraw)
              * \returns 0 on success or a negative error code on failure
              */
             int target_renderer_at_window() {
-                const int output = SDL_SetRenderTarget(this->renderer, NULL);
+                this->flush_batches();
+                const int output = SDL_SetRenderTarget(this->renderer, this->window_target);
                 if (output != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to switch the rendering target to the window [bengine::render_window::target_renderer_at_window]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to switch the rendering target to the window [bengine::render_window::target_renderer_at_window]";
                     this->print_error();
                 } else {
                     this->render_target = false;
+                    this->current_target = this->window_target;
+                    // During a partial redraw "the window" is the back buffer, clipped to what needs to be redrawn
+                    if (this->window_target != NULL) {
+                        SDL_RenderSetClipRect(this->renderer, &this->dirty_bounds);
+                    }
                 }
                 return output;
             }
-            /** Copy the dummy texture onto another texture (has a few ramifications but should be fine overall)
-             * \returns An SDL_Texture that reflects the dummy texture
+            /** Copy the dummy texture onto a new texture (prefer bengine::render_window::snapshot_render_target for copies that don't need to outlive the pool)
+             * \returns An SDL_Texture that reflects the dummy texture (the caller owns it), or NULL on failure
              */
             SDL_Texture* duplicate_dummy() {
+                if (this->dummy_texture == NULL) {
+                    return NULL;
+                }
                 int width, height;
-                SDL_BlendMode blendmode;
-
                 SDL_QueryTexture(this->dummy_texture, NULL, NULL, &width, &height);
-                SDL_GetTextureBlendMode(this->dummy_texture, &blendmode);
 
-                SDL_Texture* output = SDL_CreateTexture(this->renderer, this->dummy_pixel_format.format, SDL_TEXTUREACCESS_TARGET, width, height);
-                SDL_SetTextureBlendMode(output, SDL_BLENDMODE_NONE);
-                
-                SDL_SetRenderTarget(this->renderer, output);
-                this->clear_renderer();
-                SDL_RenderCopy(this->renderer, this->dummy_texture, NULL, NULL);
-                this->present_renderer();
-                SDL_SetTextureBlendMode(output, blendmode);
+                SDL_Texture *output = SDL_CreateTexture(this->renderer, this->dummy_pixel_format.format, SDL_TEXTUREACCESS_TARGET, width, height);
+                if (output == NULL) {
+                    std::cout << "Window \"" << this->get_title() << "\" failed to duplicate the dummy texture [bengine::render_window::duplicate_dummy]";
+                    this->print_error();
+                    return NULL;
+                }
+                this->copy_whole_texture(this->dummy_texture, output);
+                return output;
+            }
 
-                if (this->render_target) {
-                    this->target_renderer_at_dummy();
-                } else {
-                    this->target_renderer_at_window();
+            /** Get a render target from the pool, reusing an unused one with the same size and format if there is one instead of making a new texture
+             * \param width The width of the render target (px)
+             * \param height The height of the render target (px)
+             * \param format The pixel format of the render target (SDL_PIXELFORMAT_UNKNOWN for the format that the dummy texture uses)
+             * \param clear Whether to clear the render target to transparent (reused targets still hold whatever was last drawn into them)
+             * \returns A handle for the render target, or 0 on failure
+             */
+            unsigned int acquire_render_target(const int &width, const int &height, const Uint32 &format = SDL_PIXELFORMAT_UNKNOWN, const bool &clear = true) {
+                const Uint32 target_format = format == SDL_PIXELFORMAT_UNKNOWN ? this->dummy_pixel_format.format : format;
+                bengine::render_window::pooled_render_target *target = NULL;
+                for (std::size_t i = 0; i < this->render_targets.size(); i++) {
+                    const bengine::render_window::pooled_render_target &candidate = this->render_targets[i];
+                    if (candidate.id == 0 && candidate.width == width && candidate.height == height && candidate.format == target_format) {
+                        target = &this->render_targets[i];
+                        break;
+                    }
+                }
+
+                if (target == NULL) {
+                    SDL_Texture *texture = SDL_CreateTexture(this->renderer, target_format, SDL_TEXTUREACCESS_TARGET, width, height);
+                    if (texture == NULL) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to create a render target [bengine::render_window::acquire_render_target]";
+                        this->print_error();
+                        return 0;
+                    }
+                    this->render_targets.push_back({0, texture, width, height, target_format});
+                    target = &this->render_targets.back();
+                }
+                target->id = this->next_render_target_id++;
+
+                // Whatever the last user did to the texture's modulation shouldn't carry over
+                SDL_SetTextureBlendMode(target->texture, SDL_BLENDMODE_BLEND);
+                SDL_SetTextureColorMod(target->texture, 255, 255, 255);
+                SDL_SetTextureAlphaMod(target->texture, 255);
+                if (clear) {
+                    SDL_Texture *previous_target = this->current_target;
+                    if (this->retarget_renderer(target->texture) == 0) {
+                        SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, 0);
+                        SDL_RenderClear(this->renderer);
+                        this->retarget_renderer(previous_target);
+                    }
+                }
+                return target->id;
+            }
+            /** Get a named render target from the pool, so that layers which only need to be drawn once (or rarely) can stay cached across frames; the target is only made (and cleared) the first time or whenever its size or format changes
+             * \param name The name of the render target
+             * \param width The width of the render target (px)
+             * \param height The height of the render target (px)
+             * \param format The pixel format of the render target (SDL_PIXELFORMAT_UNKNOWN for the format that the dummy texture uses)
+             * \returns A handle for the render target, or 0 on failure
+             */
+            unsigned int acquire_render_target(const std::string &name, const int &width, const int &height, const Uint32 &format = SDL_PIXELFORMAT_UNKNOWN) {
+                const Uint32 target_format = format == SDL_PIXELFORMAT_UNKNOWN ? this->dummy_pixel_format.format : format;
+                const auto named = this->named_render_targets.find(name);
+                if (named != this->named_render_targets.end()) {
+                    const bengine::render_window::pooled_render_target *target = this->find_render_target(named->second);
+                    if (target != NULL && target->width == width && target->height == height && target->format == target_format) {
+                        return named->second;
+                    }
+                    this->release_render_target(named->second);
+                }
+
+                const unsigned int id = this->acquire_render_target(width, height, target_format, true);
+                if (id != 0) {
+                    this->named_render_targets[name] = id;
+                }
+                return id;
+            }
+            /** Get the handle of a named render target
+             * \param name The name that the render target was acquired under
+             * \returns The handle of the render target, or 0 if there isn't one with that name (meaning it needs to be acquired and drawn)
+             */
+            unsigned int find_render_target(const std::string &name) const {
+                const auto named = this->named_render_targets.find(name);
+                return named == this->named_render_targets.end() ? 0 : named->second;
+            }
+            /** Give a render target back to the pool so that it can be reused (it shouldn't be targeted or on the render target stack when it's released)
+             * \param id The handle returned by bengine::render_window::acquire_render_target
+             * \returns Whether there was a render target acquired under that handle
+             */
+            bool release_render_target(const unsigned int &id) {
+                bengine::render_window::pooled_render_target *target = this->find_render_target(id);
+                if (target == NULL) {
+                    return false;
+                }
+                for (auto named = this->named_render_targets.begin(); named != this->named_render_targets.end(); named++) {
+                    if (named->second == id) {
+                        this->named_render_targets.erase(named);
+                        break;
+                    }
+                }
+                target->id = 0;
+                return true;
+            }
+            /** Take a render target out of the pool entirely so that it can be handed to something that owns its texture (like a bengine::basic_texture) without copying it
+             * \param id The handle returned by bengine::render_window::acquire_render_target
+             * \returns The render target's texture (the caller owns it now), or NULL if there isn't one acquired under that handle
+             */
+            SDL_Texture* detach_render_target(const unsigned int &id) {
+                bengine::render_window::pooled_render_target *target = this->find_render_target(id);
+                if (target == NULL) {
+                    return NULL;
+                }
+                SDL_Texture *output = target->texture;
+                this->release_render_target(id);
+                this->render_targets.erase(this->render_targets.begin() + (target - this->render_targets.data()));
+                return output;
+            }
+            /** Get the texture behind a render target (for drawing it with the render functions)
+             * \param id The handle returned by bengine::render_window::acquire_render_target
+             * \returns The render target's texture, or NULL if there isn't one acquired under that handle
+             */
+            SDL_Texture* get_render_target_texture(const unsigned int &id) {
+                const bengine::render_window::pooled_render_target *target = this->find_render_target(id);
+                return target == NULL ? NULL : target->texture;
+            }
+            /** Copy a render target into another render target from the pool without touching the window (no clearing or presenting needed)
+             * \param id The handle of the render target to copy
+             * \returns A handle for the copy, or 0 on failure
+             */
+            unsigned int snapshot_render_target(const unsigned int &id) {
+                const bengine::render_window::pooled_render_target *source = this->find_render_target(id);
+                if (source == NULL) {
+                    return 0;
+                }
+                SDL_Texture *source_texture = source->texture;
+                const unsigned int output = this->acquire_render_target(source->width, source->height, source->format, false);
+                if (output != 0) {
+                    this->copy_whole_texture(source_texture, this->find_render_target(output)->texture);
+                }
+                return output;
+            }
+            /** Draw into a render target until the matching bengine::render_window::pop_render_target, remembering whatever the renderer was targeting before
+             * \param id The handle returned by bengine::render_window::acquire_render_target
+             * \returns 0 on success or a negative error code on failure (nothing is pushed on failure)
+             */
+            int push_render_target(const unsigned int &id) {
+                const bengine::render_window::pooled_render_target *target = this->find_render_target(id);
+                if (target == NULL) {
+                    std::cout << "Window \"" << this->get_title() << "\" can't push a render target that hasn't been acquired [bengine::render_window::push_render_target]\n";
+                    return -1;
+                }
+                SDL_Texture *previous_target = this->current_target;
+                const int output = this->retarget_renderer(target->texture);
+                if (output == 0) {
+                    this->render_target_stack.emplace_back(previous_target);
+                }
+                return output;
+            }
+            /** Go back to whatever the renderer was targeting before the most recent bengine::render_window::push_render_target
+             * \returns 0 on success or a negative error code on failure (including when nothing has been pushed)
+             */
+            int pop_render_target() {
+                if (this->render_target_stack.empty()) {
+                    return -1;
+                }
+                SDL_Texture *previous_target = this->render_target_stack.back();
+                this->render_target_stack.pop_back();
+                return this->retarget_renderer(previous_target);
+            }
+            /** Destroy every render target in the pool that isn't acquired
+             * \returns How many render targets were destroyed
+             */
+            std::size_t trim_render_target_pool() {
+                std::size_t output = 0;
+                for (std::size_t i = this->render_targets.size(); i-- > 0;) {
+                    if (this->render_targets[i].id == 0) {
+                        SDL_DestroyTexture(this->render_targets[i].texture);
+                        this->render_targets.erase(this->render_targets.begin() + i);
+                        output++;
+                    }
                 }
                 return output;
             }
+            /** Get how many render targets the pool holds, both acquired and unused
+             * \returns How many render targets the pool holds
+             */
+            std::size_t get_render_target_pool_size() const {
+                return this->render_targets.size();
+            }
+
+            /** Draw everything recorded in a command buffer right away
+             * \param buffer The buffer to replay (it isn't cleared)
+             */
+            void replay(const bengine::command_buffer &buffer) {
+                const std::vector<const bengine::command_buffer*> buffers = {&buffer};
+                this->replay(buffers);
+            }
+            /** Draw everything recorded in several command buffers right away, merged into one list by layer (commands on the same layer keep the order of the buffers and then the order they were recorded in)
+             * \param buffers The buffers to replay (they aren't cleared; NULL entries are skipped)
+             */
+            void replay(const std::vector<const bengine::command_buffer*> &buffers) {
+                this->replay_order.clear();
+                bool layered = false;
+                for (std::size_t i = 0; i < buffers.size(); i++) {
+                    if (buffers[i] == NULL) {
+                        continue;
+                    }
+                    const std::vector<bengine::command_buffer::command> &commands = buffers[i]->get_commands();
+                    for (std::size_t j = 0; j < commands.size(); j++) {
+                        layered |= !this->replay_order.empty() && commands[j].layer != this->replay_order.front().layer;
+                        this->replay_order.push_back({commands[j].layer, buffers[i], j});
+                    }
+                }
+                // Everything is already in buffer order, so a stable sort by layer is the whole merge (and isn't needed at all when there's only one layer)
+                if (layered) {
+                    std::stable_sort(this->replay_order.begin(), this->replay_order.end(), [](const bengine::render_window::replayed_command &lhs, const bengine::render_window::replayed_command &rhs) {
+                        return lhs.layer < rhs.layer;
+                    });
+                }
+
+                // Replaying can call back into anything, including another replay, so the order is moved out of the member while it's walked
+                std::vector<bengine::render_window::replayed_command> order;
+                order.swap(this->replay_order);
+                for (std::size_t i = 0; i < order.size(); i++) {
+                    this->replay_command(*order[i].buffer, order[i].buffer->get_commands()[order[i].index]);
+                }
+                order.clear();
+                if (this->replay_order.empty()) {
+                    order.swap(this->replay_order);
+                }
+            }
+            /** Hand a command buffer to the window to be replayed the next time it presents (or finishes a partial redraw); buffers submitted in the same frame are merged by layer, in the order they were submitted
+             * \param buffer The buffer to replay (has to stay alive and unchanged until then; it isn't cleared afterwards)
+             */
+            void submit_command_buffer(const bengine::command_buffer &buffer) {
+                this->submitted_commands.emplace_back(&buffer);
+            }
+            // \brief Throw out every submitted command buffer without replaying it
+            void discard_command_buffers() {
+                this->submitted_commands.clear();
+            }
 
             /** Render an SDL_Texture
              * \param texture The SDL_Texture to render
@@ -815,13 +2469,13 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopy(this->renderer, texture, &src, &destination) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopy(this->renderer, texture, &src, &dst) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
                     this->print_error();
                 }
             }
@@ -837,13 +2491,13 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopyEx(this->renderer, texture, &src, &destination, -angle, &center, flip) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopyEx(this->renderer, texture, &src, &dst, -angle, &center, flip) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render SDL_Texture [bengine::render_window::render_SDLTexture]";
                     this->print_error();
                 }
             }
@@ -857,13 +2511,13 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopy(this->renderer, texture.get_texture(), &frame, &destination) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopy(this->renderer, texture.get_texture(), &frame, &dst) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
                     this->print_error();
                 }
             }
@@ -879,13 +2533,13 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopyEx(this->renderer, texture.get_texture(), &frame, &destination, -angle, &pivot, flip) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopyEx(this->renderer, texture.get_texture(), &frame, &dst, -angle, &pivot, flip) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::basic_texture [bengine::render_window::render_basic_texture]";
                     this->print_error();
                 }
             }
@@ -899,13 +2553,13 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopy(this->renderer, texture.get_texture(), &frame, &destination) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopy(this->renderer, texture.get_texture(), &frame, &dst) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
                     this->print_error();
                 }
             }
@@ -921,13 +2575,13 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopyEx(this->renderer, texture.get_texture(), &frame, &destination, -angle, &pivot, flip) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopyEx(this->renderer, texture.get_texture(), &frame, &dst, -angle, &pivot, flip) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::modded_texture [bengine::render_window::render_modded_texture]";
                     this->print_error();
                 }
             }
@@ -942,18 +2596,267 @@ namespace bengine {
                 if (this->stretch_graphics) {
                     const SDL_Rect destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
                     if (SDL_RenderCopyEx(this->renderer, texture.get_texture(), &frame, &destination, -texture.get_angle(), &pivot, texture.get_flip()) != 0) {
-                        std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::shifting_texture [bengine::render_window::render_shifting_texture]";
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::shifting_texture [bengine::render_window::render_shifting_texture]";
                         this->print_error();
                     }
                     return;
                 }
                 if (SDL_RenderCopyEx(this->renderer, texture.get_texture(), &frame, &dst, -texture.get_angle(), &pivot, texture.get_flip()) != 0) {
-                    std::cout << "Window \"" << SDL_GetWindowTitle(this->window) << "\" failed to render bengine::shifting_texture [bengine::render_window::render_shifting_texture]";
+                    std::cout << "Window \"" << this->get_title() << "\" failed to render bengine::shifting_texture [bengine::render_window::render_shifting_texture]";
                     this->print_error();
                 }
             }
 
-            /** Render text using a TTF_Font based off of a point (supports most unicode characters)
+            /** Add an SDL_Texture to the sprite batch instead of drawing it right away; batched sprites are grouped by layer, blend mode, and texture and each group is drawn with a single SDL_RenderGeometry call when the batch is flushed
+             *
+             * Within a layer, sprites sharing a texture and blend mode keep their order but different textures can end up drawn in any order, so sprites that have to overlap in a certain order should go on different layers
+             *
+             * \param texture The SDL_Texture to render
+             * \param src The portion of the SDL_Texture to copy and render (px for all 4 metrics) (an empty rectangle uses the entire texture)
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
+             * \param angle The angle to rotate the texture (degrees)
+             * \param pivot The point to rotate around (px for both metrics) relative to the top-left corner of the destination rectangle
+             * \param flip How to flip the rectangle (SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL can be OR'd together)
+             * \param color_mod The color to multiply the texture by as an SDL_Color (the alpha component multiplies the texture's alpha)
+             * \param blend_mode The SDL_BlendMode to draw with (SDL_BLENDMODE_INVALID to use whatever the texture is set to)
+             * \param layer The layer to draw the sprite on (lower layers are drawn first)
+             */
+            void batch_SDLTexture(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dst, const double &angle = 0, const SDL_Point &pivot = {}, const SDL_RendererFlip &flip = SDL_FLIP_NONE, const SDL_Color &color_mod = {255, 255, 255, 255}, const SDL_BlendMode &blend_mode = SDL_BLENDMODE_INVALID, const int &layer = 0) {
+                if (texture == NULL || this->query_texture(texture) != 0 || this->queried_width == 0 || this->queried_height == 0) {
+                    return;
+                }
+
+                const bool whole_texture = src.w == 0 || src.h == 0;
+                float u1 = whole_texture ? 0.0f : static_cast<float>(src.x) / this->queried_width;
+                float v1 = whole_texture ? 0.0f : static_cast<float>(src.y) / this->queried_height;
+                float u2 = whole_texture ? 1.0f : static_cast<float>(src.x + src.w) / this->queried_width;
+                float v2 = whole_texture ? 1.0f : static_cast<float>(src.y + src.h) / this->queried_height;
+                if ((flip & SDL_FLIP_HORIZONTAL) != 0) {
+                    std::swap(u1, u2);
+                }
+                if ((flip & SDL_FLIP_VERTICAL) != 0) {
+                    std::swap(v1, v2);
+                }
+
+                SDL_Rect destination = dst;
+                SDL_Point center = pivot;
+                if (this->stretch_graphics) {
+                    destination = {this->stretch_x(dst.x), this->stretch_y(dst.y), this->stretch_x(dst.w), this->stretch_y(dst.h)};
+                    center = {this->stretch_x(pivot.x), this->stretch_y(pivot.y)};
+                }
+
+                bengine::render_window::batched_sprite sprite;
+                sprite.texture = texture;
+                sprite.blend_mode = blend_mode == SDL_BLENDMODE_INVALID ? this->queried_blend_mode : blend_mode;
+                sprite.layer = layer;
+
+                // The corners relative to the pivot, in the same order as the texture coordinates below
+                const float corner_x[4] = {static_cast<float>(-center.x), static_cast<float>(destination.w - center.x), static_cast<float>(destination.w - center.x), static_cast<float>(-center.x)};
+                const float corner_y[4] = {static_cast<float>(-center.y), static_cast<float>(-center.y), static_cast<float>(destination.h - center.y), static_cast<float>(destination.h - center.y)};
+                const float tex_u[4] = {u1, u2, u2, u1};
+                const float tex_v[4] = {v1, v1, v2, v2};
+                // Angles are counterclockwise here but clockwise for SDL, which is why SDL_RenderCopyEx gets -angle everywhere else
+                const float sine = angle == 0 ? 0.0f : static_cast<float>(std::sin(btils::degrees_to_radians(-angle)));
+                const float cosine = angle == 0 ? 1.0f : static_cast<float>(std::cos(btils::degrees_to_radians(-angle)));
+                for (unsigned char i = 0; i < 4; i++) {
+                    sprite.vertices[i].position.x = cosine * corner_x[i] - sine * corner_y[i] + destination.x + center.x;
+                    sprite.vertices[i].position.y = sine * corner_x[i] + cosine * corner_y[i] + destination.y + center.y;
+                    sprite.vertices[i].color = color_mod;
+                    sprite.vertices[i].tex_coord.x = tex_u[i];
+                    sprite.vertices[i].tex_coord.y = tex_v[i];
+                }
+                this->sprite_batch.emplace_back(sprite);
+            }
+            /** Add a bengine::basic_texture to the sprite batch (see bengine::render_window::batch_SDLTexture)
+             * \param texture The bengine::basic_texture to render
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
+             * \param layer The layer to draw the sprite on (lower layers are drawn first)
+             */
+            void batch_basic_texture(const bengine::basic_texture &texture, const SDL_Rect &dst, const int &layer = 0) {
+                this->batch_SDLTexture(texture.get_texture(), texture.get_frame(), dst, 0, {}, SDL_FLIP_NONE, {255, 255, 255, 255}, SDL_BLENDMODE_INVALID, layer);
+            }
+            /** Add a bengine::basic_texture to the sprite batch while also applying rotations/reflections (see bengine::render_window::batch_SDLTexture)
+             * \param texture The bengine::basic_texture to render
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
+             * \param angle The angle to rotate the texture (degrees)
+             * \param pivot The point to rotate around (px for both metrics) relative to the top-left corner of the destination rectangle
+             * \param flip How to flip the rectangle (SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL can be OR'd together)
+             * \param layer The layer to draw the sprite on (lower layers are drawn first)
+             */
+            void batch_basic_texture(const bengine::basic_texture &texture, const SDL_Rect &dst, const double &angle, const SDL_Point &pivot, const SDL_RendererFlip &flip, const int &layer = 0) {
+                this->batch_SDLTexture(texture.get_texture(), texture.get_frame(), dst, angle, pivot, flip, {255, 255, 255, 255}, SDL_BLENDMODE_INVALID, layer);
+            }
+            /** Add a bengine::modded_texture to the sprite batch, applying its color mod and blend mode (see bengine::render_window::batch_SDLTexture)
+             * \param texture The bengine::modded_texture to render
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
+             * \param layer The layer to draw the sprite on (lower layers are drawn first)
+             */
+            void batch_modded_texture(const bengine::modded_texture &texture, const SDL_Rect &dst, const int &layer = 0) {
+                this->batch_SDLTexture(texture.get_texture(), texture.get_frame(), dst, 0, {}, SDL_FLIP_NONE, texture.get_color_mod(), texture.get_blend_mode(), layer);
+            }
+            /** Add a bengine::modded_texture to the sprite batch while also applying rotations/reflections, its color mod, and its blend mode (see bengine::render_window::batch_SDLTexture)
+             * \param texture The bengine::modded_texture to render
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
+             * \param angle The angle to rotate the texture (degrees)
+             * \param pivot The point to rotate around (px for both metrics) relative to the top-left corner of the destination rectangle
+             * \param flip How to flip the rectangle (SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL can be OR'd together)
+             * \param layer The layer to draw the sprite on (lower layers are drawn first)
+             */
+            void batch_modded_texture(const bengine::modded_texture &texture, const SDL_Rect &dst, const double &angle, const SDL_Point &pivot, const SDL_RendererFlip &flip, const int &layer = 0) {
+                this->batch_SDLTexture(texture.get_texture(), texture.get_frame(), dst, angle, pivot, flip, texture.get_color_mod(), texture.get_blend_mode(), layer);
+            }
+            /** Add a bengine::shifting_texture to the sprite batch, applying its rotation, reflection, color mod, and blend mode (see bengine::render_window::batch_SDLTexture)
+             * \param texture The bengine::shifting_texture to render
+             * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
+             * \param layer The layer to draw the sprite on (lower layers are drawn first)
+             */
+            void batch_shifting_texture(const bengine::shifting_texture &texture, const SDL_Rect &dst, const int &layer = 0) {
+                this->batch_SDLTexture(texture.get_texture(), texture.get_frame(), dst, texture.get_angle(), texture.get_pivot(), texture.get_flip(), texture.get_color_mod(), texture.get_blend_mode(), layer);
+            }
+
+            /** Render a bengine::basic_texture over a rectangle in the world (see bengine::render_window::render_basic_texture)
+             * \param camera The camera to look through
+             * \param texture The bengine::basic_texture to render
+             * \param x x-position of the top-left corner of the rectangle (world units)
+             * \param y y-position of the top-left corner of the rectangle (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \param angle How far to rotate the texture around its center (degrees) (on top of the camera's rotation)
+             */
+            void render_basic_texture(const bengine::camera_2d &camera, const bengine::basic_texture &texture, const double &x, const double &y, const double &w, const double &h, const double &angle = 0.0) {
+                SDL_Rect dst;
+                double view_angle = angle;
+                if (!this->place_in_view(camera, x, y, w, h, dst, view_angle)) {
+                    return;
+                }
+                if (view_angle == 0.0) {
+                    this->render_basic_texture(texture, dst);
+                    return;
+                }
+                this->render_basic_texture(texture, dst, view_angle, {dst.w / 2, dst.h / 2}, SDL_FLIP_NONE);
+            }
+            /** Add part of an SDL_Texture covering a rectangle in the world to the sprite batch (see bengine::render_window::batch_SDLTexture)
+             * \param camera The camera to look through
+             * \param texture The SDL_Texture to render
+             * \param src The portion of the SDL_Texture to copy and render (px for all 4 metrics) (a width or height of 0 uses the whole texture)
+             * \param x x-position of the top-left corner of the rectangle (world units)
+             * \param y y-position of the top-left corner of the rectangle (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \param layer The layer to draw the texture on (lower layers are drawn first)
+             */
+            void batch_SDLTexture(const bengine::camera_2d &camera, SDL_Texture *texture, const SDL_Rect &src, const double &x, const double &y, const double &w, const double &h, const int &layer = 0) {
+                SDL_Rect dst;
+                double angle = 0.0;
+                if (this->place_in_view(camera, x, y, w, h, dst, angle)) {
+                    this->batch_SDLTexture(texture, src, dst, angle, {dst.w / 2, dst.h / 2}, SDL_FLIP_NONE, {255, 255, 255, 255}, SDL_BLENDMODE_INVALID, layer);
+                }
+            }
+            /** Add a bengine::basic_texture covering a rectangle in the world to the sprite batch (see bengine::render_window::batch_basic_texture)
+             * \param camera The camera to look through
+             * \param texture The bengine::basic_texture to render
+             * \param x x-position of the top-left corner of the rectangle (world units)
+             * \param y y-position of the top-left corner of the rectangle (world units)
+             * \param w Width of the rectangle (world units)
+             * \param h Height of the rectangle (world units)
+             * \param layer The layer to draw the texture on (lower layers are drawn first)
+             */
+            void batch_basic_texture(const bengine::camera_2d &camera, const bengine::basic_texture &texture, const double &x, const double &y, const double &w, const double &h, const int &layer = 0) {
+                this->batch_SDLTexture(camera, texture.get_texture(), texture.get_frame(), x, y, w, h, layer);
+            }
+            /** Get how many world-space draws have been thrown out because their camera couldn't see them since the window last presented
+             * \returns How many world-space draws have been culled since the window last presented
+             */
+            unsigned int get_culled_draws() const {
+                return this->culled_draws;
+            }
+
+            /** Draw everything in the sprite batch with one SDL_RenderGeometry call per group of sprites that share a layer, blend mode, and texture (done automatically when presenting or switching render targets)
+             * \returns 0 on success or a negative error code if any group failed to draw
+             */
+            int flush_sprite_batch() {
+                this->sprite_batch_draw_calls = 0;
+                if (this->sprite_batch.empty()) {
+                    this->queried_texture = NULL;
+                    return 0;
+                }
+
+                this->sprite_batch_order.resize(this->sprite_batch.size());
+                for (std::size_t i = 0; i < this->sprite_batch_order.size(); i++) {
+                    this->sprite_batch_order[i] = i;
+                }
+                const std::vector<bengine::render_window::batched_sprite> &sprites = this->sprite_batch;
+                std::stable_sort(this->sprite_batch_order.begin(), this->sprite_batch_order.end(), [&sprites](const std::size_t &a, const std::size_t &b) {
+                    if (sprites[a].layer != sprites[b].layer) {
+                        return sprites[a].layer < sprites[b].layer;
+                    }
+                    if (sprites[a].blend_mode != sprites[b].blend_mode) {
+                        return sprites[a].blend_mode < sprites[b].blend_mode;
+                    }
+                    return std::less<SDL_Texture*>()(sprites[a].texture, sprites[b].texture);
+                });
+
+                int output = 0;
+                std::size_t group_start = 0;
+                while (group_start < this->sprite_batch_order.size()) {
+                    const bengine::render_window::batched_sprite &first = sprites[this->sprite_batch_order[group_start]];
+                    std::size_t group_end = group_start;
+                    this->batch_vertices.clear();
+                    this->batch_indices.clear();
+                    while (group_end < this->sprite_batch_order.size()) {
+                        const bengine::render_window::batched_sprite &sprite = sprites[this->sprite_batch_order[group_end]];
+                        if (sprite.layer != first.layer || sprite.blend_mode != first.blend_mode || sprite.texture != first.texture) {
+                            break;
+                        }
+                        const int base = static_cast<int>(this->batch_vertices.size());
+                        this->batch_vertices.insert(this->batch_vertices.end(), sprite.vertices, sprite.vertices + 4);
+                        const int indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+                        this->batch_indices.insert(this->batch_indices.end(), indices, indices + 6);
+                        group_end++;
+                    }
+
+                    // SDL_RenderGeometry uses the texture's own blend mode, so it's swapped in for the group and put back afterwards
+                    SDL_BlendMode previous_blend_mode = first.blend_mode;
+                    SDL_GetTextureBlendMode(first.texture, &previous_blend_mode);
+                    if (previous_blend_mode != first.blend_mode) {
+                        SDL_SetTextureBlendMode(first.texture, first.blend_mode);
+                    }
+                    if (SDL_RenderGeometry(this->renderer, first.texture, this->batch_vertices.data(), static_cast<int>(this->batch_vertices.size()), this->batch_indices.data(), static_cast<int>(this->batch_indices.size())) != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to draw a group of batched sprites [bengine::render_window::flush_sprite_batch]";
+                        this->print_error();
+                        output = -1;
+                    }
+                    if (previous_blend_mode != first.blend_mode) {
+                        SDL_SetTextureBlendMode(first.texture, previous_blend_mode);
+                    }
+                    this->sprite_batch_draw_calls++;
+
+                    group_start = group_end;
+                }
+
+                this->sprite_batch.clear();
+                this->queried_texture = NULL;
+                return output;
+            }
+            // \brief Throw away everything in the sprite batch without drawing it
+            void discard_sprite_batch() {
+                this->sprite_batch.clear();
+                this->queried_texture = NULL;
+            }
+            /** Get how many sprites are waiting in the sprite batch
+             * \returns How many sprites are waiting in the sprite batch
+             */
+            std::size_t get_sprite_batch_size() const {
+                return this->sprite_batch.size();
+            }
+            /** Get how many SDL_RenderGeometry calls the most recent sprite batch flush took
+             * \returns How many SDL_RenderGeometry calls the most recent sprite batch flush took
+             */
+            unsigned int get_sprite_batch_draw_calls() const {
+                return this->sprite_batch_draw_calls;
+            }
+
+            /** Render text using a TTF_Font based off of a point (supports most unicode characters); text that was rendered recently with the same font, color, and wrap width comes out of the window's text cache instead of being rendered again
              * \param font The TTF_Font to use (represents both the font and size of the font)
              * \param text The text to display (literals are written as u"[text]", std::u16_string is useful too)
              * \param x x-position of the top-left corner of the text (px)
@@ -962,33 +2865,113 @@ namespace bengine {
              * \param color The color to fill the circle with as an SDL_Color
              */
             void render_text(TTF_Font *font, const char16_t *text, const int &x, const int &y, const Uint32 &wrapWidth = 0, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
-                SDL_Surface *surface = TTF_RenderUNICODE_Blended_Wrapped(font, (Uint16*)text, color, wrapWidth);
+                int width = 0, height = 0;
+                bool cached = true;
+                SDL_Texture *texture = this->get_text_texture(font, text, wrapWidth, color, width, height, cached);
+                if (texture == NULL) {
+                    return;
+                }
 
-                const SDL_Rect src = {0, 0, surface->w, surface->h};
-                const SDL_Rect dst = {x, y, surface->w, surface->h};
-                this->render_SDLTexture(SDL_CreateTextureFromSurface(this->renderer, surface), src, dst);
-                
-                SDL_FreeSurface(surface);
-                surface = nullptr;
+                const SDL_Rect src = {0, 0, width, height};
+                const SDL_Rect dst = {x, y, width, height};
+                this->render_SDLTexture(texture, src, dst);
+
+                if (!cached) {
+                    SDL_DestroyTexture(texture);
+                }
+                texture = nullptr;
             }
-            /** Render text using a TTF_Font based off of a point (supports most unicode characters)
+            /** Render text using a TTF_Font based off of a point (supports most unicode characters); text that was rendered recently with the same font, color, and wrap width comes out of the window's text cache instead of being rendered again
              * \param font The TTF_Font to use (represents both the font and size of the font)
              * \param text The text to display (literals are written as u"[text]", std::u16_string is useful too)
              * \param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the text to fill the given rectangle)
              * \param color The color to fill the circle with as an SDL_Color
              */
             void render_text(TTF_Font *font, const char16_t *text, const SDL_Rect &dst, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
-                SDL_Surface *surface = TTF_RenderUNICODE_Blended_Wrapped(font, (Uint16*)text, color, dst.w);
-                SDL_Texture *texture = SDL_CreateTextureFromSurface(this->renderer, surface);
-                
-                const SDL_Rect src = {0, 0, surface->w, surface->h};
+                int width = 0, height = 0;
+                bool cached = true;
+                SDL_Texture *texture = this->get_text_texture(font, text, dst.w, color, width, height, cached);
+                if (texture == NULL) {
+                    return;
+                }
+
+                const SDL_Rect src = {0, 0, width, height};
                 this->render_SDLTexture(texture, src, dst);
 
-                SDL_FreeSurface(surface);
-                SDL_DestroyTexture(texture);
-                surface = nullptr;
+                if (!cached) {
+                    SDL_DestroyTexture(texture);
+                }
                 texture = nullptr;
             }
+            /** Get the cache that the TTF_Font render_text functions keep their rendered text in (for its budget and hit/miss/eviction counters, or to forget a font before closing it)
+             * \returns The window's text cache
+             */
+            bengine::text_cache& get_text_cache() {
+                return this->text_textures;
+            }
+            /** Render text using a bengine::font's glyph atlas; after the first time a glyph is drawn this is one SDL_RenderGeometry call per atlas page used (normally just one) with no surfaces or textures made
+             * \param font The bengine::font to use
+             * \param text The text to display (literals are written as u"[text]", std::u16string is useful too)
+             * \param x x-position of the top-left corner of the text relative to the window (px)
+             * \param y y-position of the top-left corner of the text relative to the window (px)
+             * \param wrap_width The width to wrap the text to (px) (0 for no wrapping)
+             * \param color The color to draw the text with as an SDL_Color
+             */
+            void render_text(bengine::font &font, const char16_t *text, const int &x, const int &y, const int &wrap_width = 0, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE)) {
+                const std::vector<bengine::font::placed_glyph> &glyphs = font.layout(this->renderer, text, wrap_width);
+                for (std::size_t page = 0; page < font.get_page_count(); page++) {
+                    this->batch_vertices.clear();
+                    this->batch_indices.clear();
+                    for (std::size_t i = 0; i < glyphs.size(); i++) {
+                        if (glyphs[i].page != page) {
+                            continue;
+                        }
+                        const int base = static_cast<int>(this->batch_vertices.size());
+                        this->batch_vertices.resize(base + 4);
+                        this->make_glyph_quad(font, glyphs[i], x, y, color, &this->batch_vertices[base]);
+                        const int indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+                        this->batch_indices.insert(this->batch_indices.end(), indices, indices + 6);
+                    }
+                    if (this->batch_vertices.empty()) {
+                        continue;
+                    }
+                    if (SDL_RenderGeometry(this->renderer, font.get_page(page), this->batch_vertices.data(), static_cast<int>(this->batch_vertices.size()), this->batch_indices.data(), static_cast<int>(this->batch_indices.size())) != 0) {
+                        std::cout << "Window \"" << this->get_title() << "\" failed to render text [bengine::render_window::render_text]";
+                        this->print_error();
+                    }
+                }
+            }
+            /** Add text to the sprite batch using a bengine::font's glyph atlas (see bengine::render_window::batch_SDLTexture)
+             * \param font The bengine::font to use
+             * \param text The text to display (literals are written as u"[text]", std::u16string is useful too)
+             * \param x x-position of the top-left corner of the text relative to the window (px)
+             * \param y y-position of the top-left corner of the text relative to the window (px)
+             * \param wrap_width The width to wrap the text to (px) (0 for no wrapping)
+             * \param color The color to draw the text with as an SDL_Color
+             * \param layer The layer to draw the text on (lower layers are drawn first)
+             */
+            void batch_text(bengine::font &font, const char16_t *text, const int &x, const int &y, const int &wrap_width = 0, const SDL_Color &color = bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::WHITE), const int &layer = 0) {
+                const std::vector<bengine::font::placed_glyph> &glyphs = font.layout(this->renderer, text, wrap_width);
+                for (std::size_t i = 0; i < glyphs.size(); i++) {
+                    bengine::render_window::batched_sprite sprite;
+                    sprite.texture = font.get_page(glyphs[i].page);
+                    sprite.blend_mode = SDL_BLENDMODE_BLEND;
+                    sprite.layer = layer;
+                    this->make_glyph_quad(font, glyphs[i], x, y, color, sprite.vertices);
+                    this->sprite_batch.emplace_back(sprite);
+                }
+            }
+            /** Get the size that text would take up when drawn with a bengine::font
+             * \param font The bengine::font to use
+             * \param text The text to measure
+             * \param wrap_width The width to wrap the text to (px) (0 for no wrapping)
+             * \returns The width (x) and height (y) of the text (px)
+             */
+            SDL_Point measure_text(bengine::font &font, const char16_t *text, const int &wrap_width = 0) {
+                SDL_Point output = {0, 0};
+                font.layout(this->renderer, text, wrap_width, &output.x, &output.y);
+                return output;
+            }
     };
     const SDL_Color bengine::render_window::preset_colors[16] = {
         {  0,   0,   0, 255},
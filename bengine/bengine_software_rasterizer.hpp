@@ -0,0 +1,479 @@
+#ifndef BENGINE_SOFTWARE_RASTERIZER_hpp
+#define BENGINE_SOFTWARE_RASTERIZER_hpp
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+// SSE2 is part of every x86-64 target, so it's the baseline there; AVX2 is only used when the compiler is allowed to (-mavx2 or -march=native)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BENGINE_RASTERIZER_SSE2 1
+#include <emmintrin.h>
+#else
+#define BENGINE_RASTERIZER_SSE2 0
+#endif
+#if defined(__AVX2__)
+#define BENGINE_RASTERIZER_AVX2 1
+#include <immintrin.h>
+#else
+#define BENGINE_RASTERIZER_AVX2 0
+#endif
+
+namespace bengine {
+    /** Draws straight into a 32-bit ARGB8888 framebuffer on the CPU, filling spans several pixels at a time with SSE2 (or AVX2 when it's enabled) instead of going pixel by pixel
+     *
+     * bengine::render_window uses one for headless windows so that primitives (pixels, lines, rectangles, polygons, and the spans that ellipses are made of) skip SDL's generic software renderer; textures are still copied by SDL. It can also be pointed at any ARGB8888 surface and used on its own
+     *
+     * Blend modes follow SDL's definitions (NONE, BLEND, ADD, and MOD; anything else is treated as BLEND), and results are the same whichever instruction set ends up being used
+     */
+    class software_rasterizer {
+        private:
+            // \brief A constant color prepared for one blend mode
+            struct span_color {
+                // \brief The blend mode to draw with
+                SDL_BlendMode blend_mode;
+                // \brief The color packed as ARGB8888
+                Uint32 packed;
+                // \brief What gets added to each channel (B, G, R, A) after the destination is scaled (already multiplied out, 0 to 65025)
+                Uint16 addend[4];
+                // \brief What each destination channel (B, G, R, A) is multiplied by (0 to 255)
+                Uint16 factor[4];
+            };
+
+            // \brief The framebuffer's pixels
+            Uint32 *pixels = NULL;
+            // \brief The width of the framebuffer (px)
+            int width = 0;
+            // \brief The height of the framebuffer (px)
+            int height = 0;
+            // \brief The distance between the starts of two rows of the framebuffer (px)
+            int pitch = 0;
+            // \brief The part of the framebuffer that can be drawn to
+            SDL_Rect clip = {0, 0, 0, 0};
+
+            /** Divide by 255, rounding to the nearest integer (exact for anything up to 255 * 255)
+             * \param value The value to divide
+             * \returns The value divided by 255
+             */
+            static Uint32 divide_255(const Uint32 &value) {
+                const Uint32 biased = value + 128;
+                return (biased + (biased >> 8)) >> 8;
+            }
+            /** Get one 8-bit channel out of a packed ARGB8888 pixel
+             * \param pixel The pixel
+             * \param channel The channel (0 = blue, 1 = green, 2 = red, 3 = alpha)
+             * \returns The channel's value
+             */
+            static Uint32 get_channel(const Uint32 &pixel, const int &channel) {
+                return (pixel >> (channel * 8)) & 0xFF;
+            }
+#if BENGINE_RASTERIZER_SSE2
+            /** Divide eight 16-bit lanes by 255, rounding to the nearest integer (the same as bengine::software_rasterizer::divide_255)
+             * \param value The lanes to divide
+             * \returns The lanes divided by 255
+             */
+            static __m128i divide_255(const __m128i &value) {
+                const __m128i biased = _mm_add_epi16(value, _mm_set1_epi16(128));
+                return _mm_srli_epi16(_mm_add_epi16(biased, _mm_srli_epi16(biased, 8)), 8);
+            }
+#endif
+#if BENGINE_RASTERIZER_AVX2
+            /** Divide sixteen 16-bit lanes by 255, rounding to the nearest integer (the same as bengine::software_rasterizer::divide_255)
+             * \param value The lanes to divide
+             * \returns The lanes divided by 255
+             */
+            static __m256i divide_255(const __m256i &value) {
+                const __m256i biased = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(biased, _mm256_srli_epi16(biased, 8)), 8);
+            }
+#endif
+
+            /** Prepare a constant color for drawing
+             * \param color The color
+             * \param blend_mode The blend mode to draw with
+             * \returns The prepared color
+             */
+            static bengine::software_rasterizer::span_color prepare_color(const SDL_Color &color, const SDL_BlendMode &blend_mode) {
+                bengine::software_rasterizer::span_color output;
+                output.blend_mode = blend_mode == SDL_BLENDMODE_NONE || blend_mode == SDL_BLENDMODE_ADD || blend_mode == SDL_BLENDMODE_MOD ? blend_mode : SDL_BLENDMODE_BLEND;
+                output.packed = bengine::software_rasterizer::pack_color(color);
+                const Uint16 channels[4] = {color.b, color.g, color.r, color.a};
+                for (int i = 0; i < 4; i++) {
+                    switch (output.blend_mode) {
+                        case SDL_BLENDMODE_ADD:
+                            // dst = dst + src * srcA (saturated), alpha is left alone
+                            output.addend[i] = i == 3 ? 0 : static_cast<Uint16>(bengine::software_rasterizer::divide_255(channels[i] * color.a));
+                            output.factor[i] = 255;
+                            break;
+                        case SDL_BLENDMODE_MOD:
+                            // dst = dst * src, alpha is left alone
+                            output.addend[i] = 0;
+                            output.factor[i] = i == 3 ? 255 : channels[i];
+                            break;
+                        default:
+                            // dst = src * srcA + dst * (1 - srcA), and alpha = srcA + dstA * (1 - srcA)
+                            output.addend[i] = static_cast<Uint16>((i == 3 ? 255 : channels[i]) * color.a);
+                            output.factor[i] = static_cast<Uint16>(255 - color.a);
+                            break;
+                    }
+                }
+                // A fully opaque blend is the same as a plain overwrite, which is a lot cheaper
+                if (output.blend_mode == SDL_BLENDMODE_BLEND && color.a == 255) {
+                    output.blend_mode = SDL_BLENDMODE_NONE;
+                }
+                return output;
+            }
+            /** Blend a prepared color into one pixel
+             * \param pixel The pixel to blend into
+             * \param color The prepared color
+             */
+            static void blend_pixel(Uint32 &pixel, const bengine::software_rasterizer::span_color &color) {
+                if (color.blend_mode == SDL_BLENDMODE_NONE) {
+                    pixel = color.packed;
+                    return;
+                }
+                Uint32 output = 0;
+                for (int i = 0; i < 4; i++) {
+                    const Uint32 channel = bengine::software_rasterizer::get_channel(pixel, i);
+                    Uint32 value = 0;
+                    if (color.blend_mode == SDL_BLENDMODE_ADD) {
+                        value = std::min<Uint32>(channel + color.addend[i], 255);
+                    } else {
+                        value = bengine::software_rasterizer::divide_255(channel * color.factor[i] + color.addend[i]);
+                    }
+                    output |= value << (i * 8);
+                }
+                pixel = output;
+            }
+            /** Draw a prepared color over a run of pixels in one row
+             * \param row The first pixel of the run
+             * \param count How many pixels are in the run
+             * \param color The prepared color
+             */
+            static void fill_span(Uint32 *row, const int &count, const bengine::software_rasterizer::span_color &color) {
+                int i = 0;
+                if (color.blend_mode == SDL_BLENDMODE_NONE) {
+#if BENGINE_RASTERIZER_AVX2
+                    const __m256i fill_8 = _mm256_set1_epi32(static_cast<int>(color.packed));
+                    for (; i + 8 <= count; i += 8) {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + i), fill_8);
+                    }
+#endif
+#if BENGINE_RASTERIZER_SSE2
+                    const __m128i fill_4 = _mm_set1_epi32(static_cast<int>(color.packed));
+                    for (; i + 4 <= count; i += 4) {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), fill_4);
+                    }
+#endif
+                    for (; i < count; i++) {
+                        row[i] = color.packed;
+                    }
+                    return;
+                }
+
+#if BENGINE_RASTERIZER_SSE2
+                const __m128i zero = _mm_setzero_si128();
+                if (color.blend_mode == SDL_BLENDMODE_ADD) {
+                    const __m128i addend = _mm_set1_epi32(static_cast<int>(color.addend[0] | (color.addend[1] << 8) | (color.addend[2] << 16)));
+                    for (; i + 4 <= count; i += 4) {
+                        __m128i *target = reinterpret_cast<__m128i*>(row + i);
+                        _mm_storeu_si128(target, _mm_adds_epu8(_mm_loadu_si128(target), addend));
+                    }
+                } else {
+#if BENGINE_RASTERIZER_AVX2
+                    const __m256i zero_8 = _mm256_setzero_si256();
+                    const __m256i factor_8 = _mm256_setr_epi16(color.factor[0], color.factor[1], color.factor[2], color.factor[3], color.factor[0], color.factor[1], color.factor[2], color.factor[3], color.factor[0], color.factor[1], color.factor[2], color.factor[3], color.factor[0], color.factor[1], color.factor[2], color.factor[3]);
+                    const __m256i addend_8 = _mm256_setr_epi16(color.addend[0], color.addend[1], color.addend[2], color.addend[3], color.addend[0], color.addend[1], color.addend[2], color.addend[3], color.addend[0], color.addend[1], color.addend[2], color.addend[3], color.addend[0], color.addend[1], color.addend[2], color.addend[3]);
+                    for (; i + 8 <= count; i += 8) {
+                        __m256i *target = reinterpret_cast<__m256i*>(row + i);
+                        const __m256i pixels = _mm256_loadu_si256(target);
+                        const __m256i low = bengine::software_rasterizer::divide_255(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pixels, zero_8), factor_8), addend_8));
+                        const __m256i high = bengine::software_rasterizer::divide_255(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pixels, zero_8), factor_8), addend_8));
+                        _mm256_storeu_si256(target, _mm256_packus_epi16(low, high));
+                    }
+#endif
+                    const __m128i factor = _mm_setr_epi16(color.factor[0], color.factor[1], color.factor[2], color.factor[3], color.factor[0], color.factor[1], color.factor[2], color.factor[3]);
+                    const __m128i addend = _mm_setr_epi16(color.addend[0], color.addend[1], color.addend[2], color.addend[3], color.addend[0], color.addend[1], color.addend[2], color.addend[3]);
+                    for (; i + 4 <= count; i += 4) {
+                        __m128i *target = reinterpret_cast<__m128i*>(row + i);
+                        const __m128i pixels = _mm_loadu_si128(target);
+                        const __m128i low = bengine::software_rasterizer::divide_255(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), factor), addend));
+                        const __m128i high = bengine::software_rasterizer::divide_255(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), factor), addend));
+                        _mm_storeu_si128(target, _mm_packus_epi16(low, high));
+                    }
+                }
+#endif
+                for (; i < count; i++) {
+                    bengine::software_rasterizer::blend_pixel(row[i], color);
+                }
+            }
+            /** Normalize a rectangle with a negative width or height and cut it down to the clip rectangle
+             * \param rectangle The rectangle
+             * \param output Where to store the clipped rectangle
+             * \returns Whether any of the rectangle is left
+             */
+            bool clip_rectangle(SDL_Rect rectangle, SDL_Rect &output) const {
+                if (rectangle.w < 0) {
+                    rectangle.x += rectangle.w;
+                    rectangle.w = -rectangle.w;
+                }
+                if (rectangle.h < 0) {
+                    rectangle.y += rectangle.h;
+                    rectangle.h = -rectangle.h;
+                }
+                const int left = std::max(rectangle.x, this->clip.x), right = std::min(rectangle.x + rectangle.w, this->clip.x + this->clip.w);
+                const int top = std::max(rectangle.y, this->clip.y), bottom = std::min(rectangle.y + rectangle.h, this->clip.y + this->clip.h);
+                if (left >= right || top >= bottom) {
+                    return false;
+                }
+                output = {left, top, right - left, bottom - top};
+                return true;
+            }
+            /** Check whether a pixel is inside the clip rectangle
+             * \param x x-position of the pixel (px)
+             * \param y y-position of the pixel (px)
+             * \returns Whether the pixel can be drawn to
+             */
+            bool is_clipped_in(const int &x, const int &y) const {
+                return x >= this->clip.x && y >= this->clip.y && x < this->clip.x + this->clip.w && y < this->clip.y + this->clip.h;
+            }
+            /** Get a row of the framebuffer
+             * \param y The row (px)
+             * \returns The first pixel of the row
+             */
+            Uint32* get_row(const int &y) const {
+                return this->pixels + static_cast<std::ptrdiff_t>(y) * this->pitch;
+            }
+            /** Fill one horizontal run of pixels, clipping it first
+             * \param x1 x-position of the first pixel (px)
+             * \param x2 x-position just past the last pixel (px)
+             * \param y y-position of the run (px)
+             * \param color The prepared color
+             */
+            void fill_clipped_span(int x1, int x2, const int &y, const bengine::software_rasterizer::span_color &color) {
+                if (y < this->clip.y || y >= this->clip.y + this->clip.h) {
+                    return;
+                }
+                x1 = std::max(x1, this->clip.x);
+                x2 = std::min(x2, this->clip.x + this->clip.w);
+                if (x1 < x2) {
+                    bengine::software_rasterizer::fill_span(this->get_row(y) + x1, x2 - x1, color);
+                }
+            }
+            /** Check that a surface can be read from or drawn into
+             * \param surface The surface
+             * \returns Whether the surface is ARGB8888 with its pixels available
+             */
+            static bool is_usable(const SDL_Surface *surface) {
+                return surface != NULL && surface->pixels != NULL && surface->format != NULL && surface->format->format == SDL_PIXELFORMAT_ARGB8888;
+            }
+
+        public:
+            // \brief bengine::software_rasterizer constructor
+            software_rasterizer() {}
+            // \brief bengine::software_rasterizer deconstructor
+            ~software_rasterizer() {}
+
+            /** Pack an SDL_Color into an ARGB8888 pixel
+             * \param color The color
+             * \returns The color as an ARGB8888 pixel
+             */
+            static Uint32 pack_color(const SDL_Color &color) {
+                return (static_cast<Uint32>(color.a) << 24) | (static_cast<Uint32>(color.r) << 16) | (static_cast<Uint32>(color.g) << 8) | color.b;
+            }
+
+            /** Point the rasterizer at a framebuffer (which resets the clip rectangle)
+             * \param pixels The framebuffer's pixels (ARGB8888)
+             * \param width The width of the framebuffer (px)
+             * \param height The height of the framebuffer (px)
+             * \param pitch The distance between the starts of two rows of the framebuffer (bytes; a multiple of 4)
+             */
+            void set_target(Uint32 *pixels, const int &width, const int &height, const int &pitch) {
+                this->pixels = pixels;
+                this->width = pixels == NULL ? 0 : width;
+                this->height = pixels == NULL ? 0 : height;
+                this->pitch = pitch / static_cast<int>(sizeof(Uint32));
+                this->set_clip(NULL);
+            }
+            /** Point the rasterizer at a surface (which resets the clip rectangle)
+             * \param surface The surface (has to be ARGB8888 and not need locking, like the ones made by SDL_CreateRGBSurfaceWithFormat)
+             * \returns Whether the surface can be drawn into
+             */
+            bool set_target(SDL_Surface *surface) {
+                if (!bengine::software_rasterizer::is_usable(surface)) {
+                    this->set_target(NULL, 0, 0, 0);
+                    return false;
+                }
+                this->set_target(static_cast<Uint32*>(surface->pixels), surface->w, surface->h, surface->pitch);
+                return true;
+            }
+            /** Check whether the rasterizer has a framebuffer to draw into
+             * \returns Whether the rasterizer has a framebuffer to draw into
+             */
+            bool has_target() const {
+                return this->pixels != NULL;
+            }
+            /** Limit drawing to part of the framebuffer
+             * \param clip The part of the framebuffer that can be drawn to (NULL for all of it)
+             */
+            void set_clip(const SDL_Rect *clip) {
+                const SDL_Rect whole = {0, 0, this->width, this->height};
+                if (clip == NULL || !SDL_IntersectRect(clip, &whole, &this->clip)) {
+                    this->clip = clip == NULL ? whole : SDL_Rect{0, 0, 0, 0};
+                }
+            }
+
+            /** Overwrite the whole framebuffer with a color (ignores the clip rectangle and blend mode, like SDL_RenderClear)
+             * \param color The color
+             */
+            void clear(const SDL_Color &color) {
+                const bengine::software_rasterizer::span_color prepared = bengine::software_rasterizer::prepare_color(color, SDL_BLENDMODE_NONE);
+                for (int y = 0; y < this->height; y++) {
+                    bengine::software_rasterizer::fill_span(this->get_row(y), this->width, prepared);
+                }
+            }
+            /** Fill rectangles (negative widths and heights are flipped rather than ignored)
+             * \param rectangles The rectangles (px for all 4 metrics)
+             * \param count How many rectangles there are
+             * \param color The color to fill them with
+             * \param blend_mode The blend mode to draw with
+             */
+            void fill_rectangles(const SDL_Rect *rectangles, const int &count, const SDL_Color &color, const SDL_BlendMode &blend_mode) {
+                const bengine::software_rasterizer::span_color prepared = bengine::software_rasterizer::prepare_color(color, blend_mode);
+                SDL_Rect clipped;
+                for (int i = 0; i < count; i++) {
+                    if (!this->clip_rectangle(rectangles[i], clipped)) {
+                        continue;
+                    }
+                    for (int y = clipped.y; y < clipped.y + clipped.h; y++) {
+                        bengine::software_rasterizer::fill_span(this->get_row(y) + clipped.x, clipped.w, prepared);
+                    }
+                }
+            }
+            /** Draw the outlines of rectangles (each pixel is only drawn once, so blended outlines don't get darker corners)
+             * \param rectangles The rectangles (px for all 4 metrics)
+             * \param count How many rectangles there are
+             * \param color The color to draw them with
+             * \param blend_mode The blend mode to draw with
+             */
+            void draw_rectangles(const SDL_Rect *rectangles, const int &count, const SDL_Color &color, const SDL_BlendMode &blend_mode) {
+                const bengine::software_rasterizer::span_color prepared = bengine::software_rasterizer::prepare_color(color, blend_mode);
+                for (int i = 0; i < count; i++) {
+                    SDL_Rect rectangle = rectangles[i];
+                    if (rectangle.w < 0) {
+                        rectangle.x += rectangle.w;
+                        rectangle.w = -rectangle.w;
+                    }
+                    if (rectangle.h < 0) {
+                        rectangle.y += rectangle.h;
+                        rectangle.h = -rectangle.h;
+                    }
+                    if (rectangle.w == 0 || rectangle.h == 0) {
+                        continue;
+                    }
+                    this->fill_clipped_span(rectangle.x, rectangle.x + rectangle.w, rectangle.y, prepared);
+                    if (rectangle.h > 1) {
+                        this->fill_clipped_span(rectangle.x, rectangle.x + rectangle.w, rectangle.y + rectangle.h - 1, prepared);
+                    }
+                    for (int y = rectangle.y + 1; y < rectangle.y + rectangle.h - 1; y++) {
+                        this->fill_clipped_span(rectangle.x, rectangle.x + 1, y, prepared);
+                        if (rectangle.w > 1) {
+                            this->fill_clipped_span(rectangle.x + rectangle.w - 1, rectangle.x + rectangle.w, y, prepared);
+                        }
+                    }
+                }
+            }
+            /** Draw single pixels
+             * \param points The pixels (px)
+             * \param count How many pixels there are
+             * \param color The color to draw them with
+             * \param blend_mode The blend mode to draw with
+             */
+            void draw_points(const SDL_Point *points, const int &count, const SDL_Color &color, const SDL_BlendMode &blend_mode) {
+                const bengine::software_rasterizer::span_color prepared = bengine::software_rasterizer::prepare_color(color, blend_mode);
+                for (int i = 0; i < count; i++) {
+                    if (this->is_clipped_in(points[i].x, points[i].y)) {
+                        bengine::software_rasterizer::blend_pixel(this->get_row(points[i].y)[points[i].x], prepared);
+                    }
+                }
+            }
+            /** Draw a line including both of its endpoints (Bresenham's algorithm; horizontal lines are filled as a single span)
+             * \param x1 x-position of the starting point (px)
+             * \param y1 y-position of the starting point (px)
+             * \param x2 x-position of the ending point (px)
+             * \param y2 y-position of the ending point (px)
+             * \param color The color to draw the line with
+             * \param blend_mode The blend mode to draw with
+             */
+            void draw_line(const int &x1, const int &y1, const int &x2, const int &y2, const SDL_Color &color, const SDL_BlendMode &blend_mode) {
+                const bengine::software_rasterizer::span_color prepared = bengine::software_rasterizer::prepare_color(color, blend_mode);
+                if (y1 == y2) {
+                    this->fill_clipped_span(std::min(x1, x2), std::max(x1, x2) + 1, y1, prepared);
+                    return;
+                }
+
+                const int dx = std::abs(x2 - x1), dy = -std::abs(y2 - y1);
+                const int step_x = x1 < x2 ? 1 : -1, step_y = y1 < y2 ? 1 : -1;
+                int error = dx + dy;
+                int x = x1, y = y1;
+                while (true) {
+                    if (this->is_clipped_in(x, y)) {
+                        bengine::software_rasterizer::blend_pixel(this->get_row(y)[x], prepared);
+                    }
+                    if (x == x2 && y == y2) {
+                        break;
+                    }
+                    const int doubled_error = error * 2;
+                    if (doubled_error >= dy) {
+                        error += dy;
+                        x += step_x;
+                    }
+                    if (doubled_error <= dx) {
+                        error += dx;
+                        y += step_y;
+                    }
+                }
+            }
+            /** Fill a convex polygon, covering every pixel whose center is inside of it (so polygons that share an edge neither overlap nor leave a gap between them, like with SDL_RenderGeometry)
+             * \param points The corners of the polygon in order (px; either winding works)
+             * \param count How many corners there are
+             * \param color The color to fill it with
+             * \param blend_mode The blend mode to draw with
+             */
+            void fill_polygon(const SDL_FPoint *points, const int &count, const SDL_Color &color, const SDL_BlendMode &blend_mode) {
+                if (count < 3) {
+                    return;
+                }
+                float top = points[0].y, bottom = points[0].y;
+                for (int i = 1; i < count; i++) {
+                    top = std::min(top, points[i].y);
+                    bottom = std::max(bottom, points[i].y);
+                }
+
+                const bengine::software_rasterizer::span_color prepared = bengine::software_rasterizer::prepare_color(color, blend_mode);
+                const int first_row = std::max(static_cast<int>(std::ceil(top - 0.5f)), this->clip.y);
+                const int last_row = std::min(static_cast<int>(std::ceil(bottom - 0.5f)), this->clip.y + this->clip.h);
+                for (int y = first_row; y < last_row; y++) {
+                    const float center = y + 0.5f;
+                    float left = std::numeric_limits<float>::max(), right = std::numeric_limits<float>::lowest();
+                    for (int i = 0; i < count; i++) {
+                        const SDL_FPoint &start = points[i], &end = points[(i + 1) % count];
+                        // Each edge covers its top end but not its bottom end, so a corner that two edges share is only counted once
+                        if ((start.y <= center) == (end.y <= center)) {
+                            continue;
+                        }
+                        const float x = start.x + (center - start.y) * (end.x - start.x) / (end.y - start.y);
+                        left = std::min(left, x);
+                        right = std::max(right, x);
+                    }
+                    if (left < right) {
+                        this->fill_clipped_span(static_cast<int>(std::ceil(left - 0.5f)), static_cast<int>(std::ceil(right - 0.5f)), y, prepared);
+                    }
+                }
+            }
+    };
+}
+
+#endif // BENGINE_SOFTWARE_RASTERIZER_hpp
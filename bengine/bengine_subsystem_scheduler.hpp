@@ -0,0 +1,200 @@
+#ifndef BENGINE_SUBSYSTEM_SCHEDULER_hpp
+#define BENGINE_SUBSYSTEM_SCHEDULER_hpp
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "bengine_clock.hpp"
+
+namespace bengine {
+    /** Runs several update functions ("subsystems") at their own fixed rates off of a single simulation clock, so that expensive low-frequency work (AI, pathing, etc) stops costing anything on the ticks where it isn't due
+     *
+     * bengine::loop advances its scheduler by delta_time after every compute(), so subsystems share the loop's accumulator and overload handling: a subsystem faster than the loop runs several times in one tick and a slower one skips ticks; subsystems registered with a rate of 0 run once per rendered frame instead
+     */
+    class subsystem_scheduler {
+        private:
+            // \brief A registered update function and its timing
+            struct subsystem {
+                // \brief A name for the subsystem (only used for reporting)
+                std::string name;
+                // \brief The update function; gets passed the amount of simulation time that it should advance by (seconds)
+                std::function<void(double)> update;
+                // \brief The time between updates (seconds); 0 for once per frame
+                double period;
+                // \brief The simulation time that the next update is due at (seconds)
+                long double next_time;
+                // \brief Whether the subsystem should be updated at all
+                bool enabled;
+                // \brief How many times the subsystem has been updated
+                unsigned long long updates;
+                // \brief How long the most recent update took (seconds)
+                double last_duration;
+                // \brief The handle that the subsystem was registered with
+                unsigned int id;
+            };
+
+            // \brief Every registered subsystem
+            std::vector<bengine::subsystem_scheduler::subsystem> subsystems;
+            // \brief The handle that the next registered subsystem will get
+            unsigned int next_id = 1;
+            // \brief The simulation time that the scheduler has been advanced to (seconds)
+            long double time = 0.0;
+
+            /** Find a subsystem by its handle
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \returns The subsystem, or NULL if there isn't one with that handle
+             */
+            bengine::subsystem_scheduler::subsystem* find(const unsigned int &id) {
+                for (std::size_t i = 0; i < this->subsystems.size(); i++) {
+                    if (this->subsystems[i].id == id) {
+                        return &this->subsystems[i];
+                    }
+                }
+                return NULL;
+            }
+            /** Find a subsystem by its handle
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \returns The subsystem, or NULL if there isn't one with that handle
+             */
+            const bengine::subsystem_scheduler::subsystem* find(const unsigned int &id) const {
+                for (std::size_t i = 0; i < this->subsystems.size(); i++) {
+                    if (this->subsystems[i].id == id) {
+                        return &this->subsystems[i];
+                    }
+                }
+                return NULL;
+            }
+            /** Run a subsystem's update function while timing it
+             * \param subsystem The subsystem to update
+             * \param step How much simulation time to advance the subsystem by (seconds)
+             */
+            static void run(bengine::subsystem_scheduler::subsystem &subsystem, const double &step) {
+                const Uint64 start = bengine::precision_clock::now();
+                subsystem.update(step);
+                subsystem.last_duration = bengine::precision_clock::seconds_since(start);
+                subsystem.updates++;
+            }
+
+        public:
+            // \brief bengine::subsystem_scheduler constructor
+            subsystem_scheduler() {}
+            // \brief bengine::subsystem_scheduler deconstructor
+            ~subsystem_scheduler() {}
+
+            /** Register a subsystem (subsystems shouldn't be added or removed from within an update function)
+             * \param update The update function; gets passed the amount of simulation time that it should advance by (seconds), which is always 1 / rate for fixed-rate subsystems
+             * \param rate How many times a second to update the subsystem (Hz); 0 to update it once per rendered frame with the frame's duration
+             * \param phase How far into its period the subsystem's first update is pushed, as a fraction on the interval [0, 1); giving several slow subsystems different phases spreads them across different ticks
+             * \param name A name for the subsystem (only used for reporting)
+             * \returns A handle for the subsystem
+             */
+            unsigned int add(const std::function<void(double)> &update, const double &rate, const double &phase = 0.0, const std::string &name = "") {
+                const double period = rate > 0 ? 1.0 / rate : 0.0;
+                this->subsystems.push_back({name, update, period, this->time + period * phase, true, 0, 0.0, this->next_id});
+                return this->next_id++;
+            }
+            /** Unregister a subsystem (subsystems shouldn't be added or removed from within an update function)
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \returns Whether there was a subsystem with that handle
+             */
+            bool remove(const unsigned int &id) {
+                for (std::size_t i = 0; i < this->subsystems.size(); i++) {
+                    if (this->subsystems[i].id == id) {
+                        this->subsystems.erase(this->subsystems.begin() + i);
+                        return true;
+                    }
+                }
+                return false;
+            }
+            // \brief Unregister every subsystem
+            void clear() {
+                this->subsystems.clear();
+            }
+
+            /** Change how often a subsystem is updated; its next update is rescheduled from now
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \param rate How many times a second to update the subsystem (Hz); 0 to update it once per rendered frame
+             */
+            void set_rate(const unsigned int &id, const double &rate) {
+                bengine::subsystem_scheduler::subsystem *subsystem = this->find(id);
+                if (subsystem != NULL) {
+                    subsystem->period = rate > 0 ? 1.0 / rate : 0.0;
+                    subsystem->next_time = this->time + subsystem->period;
+                }
+            }
+            /** Stop or start updating a subsystem; a re-enabled subsystem picks back up from now instead of catching up on everything it missed
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \param enabled Whether the subsystem should be updated
+             */
+            void set_enabled(const unsigned int &id, const bool &enabled) {
+                bengine::subsystem_scheduler::subsystem *subsystem = this->find(id);
+                if (subsystem != NULL && subsystem->enabled != enabled) {
+                    subsystem->enabled = enabled;
+                    if (enabled && subsystem->next_time < this->time) {
+                        subsystem->next_time = this->time;
+                    }
+                }
+            }
+
+            /** Get how many times a subsystem has been updated
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \returns How many times the subsystem has been updated (0 if there isn't one with that handle)
+             */
+            unsigned long long get_updates(const unsigned int &id) const {
+                const bengine::subsystem_scheduler::subsystem *subsystem = this->find(id);
+                return subsystem == NULL ? 0 : subsystem->updates;
+            }
+            /** Get how long a subsystem's most recent update took
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \returns How long the subsystem's most recent update took (seconds)
+             */
+            double get_last_duration(const unsigned int &id) const {
+                const bengine::subsystem_scheduler::subsystem *subsystem = this->find(id);
+                return subsystem == NULL ? 0.0 : subsystem->last_duration;
+            }
+            /** Get a subsystem's name
+             * \param id The handle returned by bengine::subsystem_scheduler::add
+             * \returns The subsystem's name (empty if there isn't one with that handle)
+             */
+            std::string get_name(const unsigned int &id) const {
+                const bengine::subsystem_scheduler::subsystem *subsystem = this->find(id);
+                return subsystem == NULL ? std::string() : subsystem->name;
+            }
+            /** Get how many subsystems are registered
+             * \returns How many subsystems are registered
+             */
+            std::size_t get_size() const {
+                return this->subsystems.size();
+            }
+
+            /** Advance the simulation clock and update every fixed-rate subsystem as many times as it's due (called by bengine::loop after every compute())
+             * \param delta_time How much simulation time passed (seconds)
+             */
+            void tick(const double &delta_time) {
+                this->time += delta_time;
+                for (std::size_t i = 0; i < this->subsystems.size(); i++) {
+                    bengine::subsystem_scheduler::subsystem &subsystem = this->subsystems[i];
+                    if (!subsystem.enabled || subsystem.period <= 0) {
+                        continue;
+                    }
+                    while (subsystem.next_time <= this->time) {
+                        bengine::subsystem_scheduler::run(subsystem, subsystem.period);
+                        subsystem.next_time += subsystem.period;
+                    }
+                }
+            }
+            /** Update every once-per-frame subsystem (called by bengine::loop once per frame, after the computation steps)
+             * \param frame_duration How long the frame took (seconds)
+             */
+            void frame(const double &frame_duration) {
+                for (std::size_t i = 0; i < this->subsystems.size(); i++) {
+                    if (this->subsystems[i].enabled && this->subsystems[i].period <= 0) {
+                        bengine::subsystem_scheduler::run(this->subsystems[i], frame_duration);
+                    }
+                }
+            }
+    };
+}
+
+#endif // BENGINE_SUBSYSTEM_SCHEDULER_hpp
@@ -0,0 +1,327 @@
+#ifndef BENGINE_TASK_SCHEDULER_hpp
+#define BENGINE_TASK_SCHEDULER_hpp
+
+// Coroutines need C++20; under older standards this header is empty and bengine::loop goes without a task scheduler
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define BENGINE_COROUTINES 1
+#else
+#define BENGINE_COROUTINES 0
+#endif
+
+#if BENGINE_COROUTINES
+
+#include <SDL2/SDL.h>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "bengine_clock.hpp"
+
+namespace bengine {
+    class task_scheduler;
+
+    /** A coroutine that can be handed to a bengine::task_scheduler; any function returning bengine::task that uses co_await is one
+     *
+     * A task doesn't start until it's spawned, and once spawned it belongs to the scheduler (which destroys it when it finishes or when the scheduler itself is destroyed)
+     */
+    class task {
+        public:
+            // \brief The promise type that the compiler uses for functions returning bengine::task
+            struct promise_type {
+                bengine::task get_return_object() {
+                    return bengine::task(std::coroutine_handle<bengine::task::promise_type>::from_promise(*this));
+                }
+                std::suspend_always initial_suspend() noexcept {
+                    return {};
+                }
+                std::suspend_always final_suspend() noexcept {
+                    return {};
+                }
+                void return_void() {}
+                void unhandled_exception() {
+                    std::terminate();
+                }
+            };
+
+        private:
+            // \brief The coroutine (NULL once it has been handed to a scheduler)
+            std::coroutine_handle<bengine::task::promise_type> handle = nullptr;
+
+            friend class bengine::task_scheduler;
+
+        public:
+            /** bengine::task constructor
+             * \param handle The coroutine to own
+             */
+            explicit task(std::coroutine_handle<bengine::task::promise_type> handle) : handle(handle) {}
+            task(const bengine::task&) = delete;
+            task(bengine::task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+            bengine::task& operator=(const bengine::task&) = delete;
+            bengine::task& operator=(bengine::task &&other) noexcept {
+                if (this != &other) {
+                    if (this->handle) {
+                        this->handle.destroy();
+                    }
+                    this->handle = std::exchange(other.handle, nullptr);
+                }
+                return *this;
+            }
+            // \brief bengine::task deconstructor; only destroys the coroutine if it was never spawned
+            ~task() {
+                if (this->handle) {
+                    this->handle.destroy();
+                }
+            }
+    };
+
+    /** Runs bengine::task coroutines that co_await a number of ticks, an amount of real time, or an SDL event
+     *
+     * Tick waits sit in a timer wheel (only the current slot is looked at each tick), timed waits sit in a min-heap (only the earliest deadline is looked at), and event waits sit in a table keyed by event type, so a waiting task costs nothing per tick no matter how many of them there are
+     *
+     * bengine::loop drives its scheduler automatically: tick() is called before every compute() and every processed event is passed to handle_event(), so tasks resume just ahead of the computation step that they belong to
+     */
+    class task_scheduler {
+        private:
+            // \brief The amount of slots in the timer wheel (a power of two); waits longer than this just stay in their slot for extra laps
+            static const std::size_t wheel_size = 256;
+
+            // \brief A task waiting on a tick count
+            struct tick_waiter {
+                // \brief The tick to resume on
+                unsigned long long due_tick;
+                // \brief The task to resume
+                std::coroutine_handle<> handle;
+            };
+            // \brief A task waiting on an amount of real time
+            struct time_waiter {
+                // \brief The counter value to resume at
+                Uint64 deadline;
+                // \brief Breaks ties between equal deadlines so that tasks resume in the order they started waiting
+                unsigned long long order;
+                // \brief The task to resume
+                std::coroutine_handle<> handle;
+
+                bool operator>(const bengine::task_scheduler::time_waiter &other) const {
+                    return this->deadline != other.deadline ? this->deadline > other.deadline : this->order > other.order;
+                }
+            };
+
+        public:
+            // \brief The awaitable returned by bengine::task_scheduler::wait_ticks
+            struct tick_awaiter {
+                // \brief The scheduler to wait on
+                bengine::task_scheduler *scheduler;
+                // \brief How many ticks to wait
+                unsigned long long ticks;
+
+                bool await_ready() const noexcept {
+                    return this->ticks == 0;
+                }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    this->scheduler->schedule_tick(handle, this->ticks);
+                }
+                void await_resume() const noexcept {}
+            };
+            // \brief The awaitable returned by bengine::task_scheduler::wait_seconds
+            struct time_awaiter {
+                // \brief The scheduler to wait on
+                bengine::task_scheduler *scheduler;
+                // \brief How long to wait (seconds)
+                double seconds;
+
+                bool await_ready() const noexcept {
+                    return this->seconds <= 0;
+                }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    this->scheduler->schedule_time(handle, this->seconds);
+                }
+                void await_resume() const noexcept {}
+            };
+            // \brief The awaitable returned by bengine::task_scheduler::wait_event; co_await gives back the event that resumed the task
+            struct event_awaiter {
+                // \brief The scheduler to wait on
+                bengine::task_scheduler *scheduler;
+                // \brief The type of event to wait for
+                Uint32 type;
+                // \brief The event that resumed the task (filled in by bengine::task_scheduler::handle_event)
+                SDL_Event event;
+
+                bool await_ready() const noexcept {
+                    return false;
+                }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    this->scheduler->event_waiters[this->type].emplace_back(handle, this);
+                }
+                SDL_Event await_resume() const noexcept {
+                    return this->event;
+                }
+            };
+
+        private:
+            // \brief The timer wheel; a tick wait goes into the slot for its due tick
+            std::vector<bengine::task_scheduler::tick_waiter> wheel[bengine::task_scheduler::wheel_size];
+            // \brief Timed waits ordered so that the earliest deadline is on top
+            std::priority_queue<bengine::task_scheduler::time_waiter, std::vector<bengine::task_scheduler::time_waiter>, std::greater<bengine::task_scheduler::time_waiter>> timers;
+            // \brief Counts timed waits so that equal deadlines keep their order
+            unsigned long long timer_order = 0;
+            // \brief Event waits keyed by event type, along with the awaiter to hand the event to
+            std::unordered_map<Uint32, std::vector<std::pair<std::coroutine_handle<>, bengine::task_scheduler::event_awaiter*>>> event_waiters;
+            // \brief Tasks that are due to resume on the next tick
+            std::vector<std::coroutine_handle<>> ready;
+            // \brief The tasks being resumed this tick (kept around so its memory is reused)
+            std::vector<std::coroutine_handle<>> resuming;
+            // \brief Every task that has been spawned and hasn't finished
+            std::unordered_set<void*> live_tasks;
+
+            // \brief How many times bengine::task_scheduler::tick has been called
+            unsigned long long current_tick = 0;
+
+            /** Put a task into the timer wheel
+             * \param handle The task to resume later
+             * \param ticks How many ticks from now to resume it
+             */
+            void schedule_tick(std::coroutine_handle<> handle, const unsigned long long &ticks) {
+                const unsigned long long due_tick = this->current_tick + ticks;
+                this->wheel[due_tick & (bengine::task_scheduler::wheel_size - 1)].push_back({due_tick, handle});
+            }
+            /** Put a task into the timer heap
+             * \param handle The task to resume later
+             * \param seconds How long from now to resume it (seconds)
+             */
+            void schedule_time(std::coroutine_handle<> handle, const double &seconds) {
+                this->timers.push({bengine::precision_clock::now() + bengine::precision_clock::to_ticks(seconds), this->timer_order++, handle});
+            }
+            /** Resume a task and clean it up if it ran to completion
+             * \param handle The task to resume
+             */
+            void resume(std::coroutine_handle<> handle) {
+                handle.resume();
+                if (handle.done()) {
+                    this->live_tasks.erase(handle.address());
+                    handle.destroy();
+                }
+            }
+
+        public:
+            // \brief bengine::task_scheduler constructor
+            task_scheduler() {}
+            task_scheduler(const bengine::task_scheduler&) = delete;
+            bengine::task_scheduler& operator=(const bengine::task_scheduler&) = delete;
+            // \brief bengine::task_scheduler deconstructor; destroys every task that hasn't finished
+            ~task_scheduler() {
+                this->clear();
+            }
+
+            /** Start running a task; it runs right away until its first co_await
+             * \param task The task to run (the scheduler takes ownership of it)
+             */
+            void spawn(bengine::task &&task) {
+                std::coroutine_handle<> handle = std::exchange(task.handle, nullptr);
+                if (!handle) {
+                    return;
+                }
+                this->live_tasks.insert(handle.address());
+                this->resume(handle);
+            }
+            // \brief Destroy every task that hasn't finished yet
+            void clear() {
+                for (void *address : this->live_tasks) {
+                    std::coroutine_handle<>::from_address(address).destroy();
+                }
+                this->live_tasks.clear();
+                for (std::size_t i = 0; i < bengine::task_scheduler::wheel_size; i++) {
+                    this->wheel[i].clear();
+                }
+                this->timers = {};
+                this->event_waiters.clear();
+                this->ready.clear();
+            }
+
+            /** Wait for a number of ticks (co_await the result)
+             * \param ticks How many ticks to wait (0 doesn't wait at all)
+             * \returns An awaitable
+             */
+            bengine::task_scheduler::tick_awaiter wait_ticks(const unsigned long long &ticks) {
+                return {this, ticks};
+            }
+            /** Wait for an amount of real time; the task resumes on the first tick at or after the deadline (co_await the result)
+             * \param seconds How long to wait (seconds)
+             * \returns An awaitable
+             */
+            bengine::task_scheduler::time_awaiter wait_seconds(const double &seconds) {
+                return {this, seconds};
+            }
+            /** Wait for an SDL event of a certain type; the task resumes on the tick after the event is handled and co_await gives back the event
+             * \param type The type of event to wait for (an SDL_EventType or a type from SDL_RegisterEvents)
+             * \returns An awaitable
+             */
+            bengine::task_scheduler::event_awaiter wait_event(const Uint32 &type) {
+                return {this, type, SDL_Event()};
+            }
+
+            /** Wake up every task waiting on this type of event (they resume on the next tick)
+             * \param event The event that happened
+             */
+            void handle_event(const SDL_Event &event) {
+                const auto waiters = this->event_waiters.find(event.type);
+                if (waiters == this->event_waiters.end()) {
+                    return;
+                }
+                for (std::size_t i = 0; i < waiters->second.size(); i++) {
+                    waiters->second[i].second->event = event;
+                    this->ready.emplace_back(waiters->second[i].first);
+                }
+                this->event_waiters.erase(waiters);
+            }
+            // \brief Advance by one tick and resume every task that is due
+            void tick() {
+                this->current_tick++;
+
+                std::vector<bengine::task_scheduler::tick_waiter> &slot = this->wheel[this->current_tick & (bengine::task_scheduler::wheel_size - 1)];
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < slot.size(); i++) {
+                    if (slot[i].due_tick <= this->current_tick) {
+                        this->ready.emplace_back(slot[i].handle);
+                    } else {
+                        slot[kept++] = slot[i];
+                    }
+                }
+                slot.resize(kept);
+
+                const Uint64 now = bengine::precision_clock::now();
+                while (!this->timers.empty() && this->timers.top().deadline <= now) {
+                    this->ready.emplace_back(this->timers.top().handle);
+                    this->timers.pop();
+                }
+
+                // Tasks that start waiting again while being resumed land in the next batch instead of this one
+                this->resuming.swap(this->ready);
+                for (std::size_t i = 0; i < this->resuming.size(); i++) {
+                    this->resume(this->resuming[i]);
+                }
+                this->resuming.clear();
+            }
+
+            /** Get how many times the scheduler has ticked
+             * \returns How many times the scheduler has ticked
+             */
+            unsigned long long get_current_tick() const {
+                return this->current_tick;
+            }
+            /** Get how many tasks have been spawned and haven't finished
+             * \returns How many tasks have been spawned and haven't finished
+             */
+            std::size_t get_task_count() const {
+                return this->live_tasks.size();
+            }
+    };
+}
+
+#endif // BENGINE_COROUTINES
+
+#endif // BENGINE_TASK_SCHEDULER_hpp
@@ -0,0 +1,274 @@
+#ifndef BENGINE_TEXT_CACHE_hpp
+#define BENGINE_TEXT_CACHE_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bengine {
+    /** A least-recently-used cache of text that has already been rendered into textures, keyed by font, text, color, and wrap width, and bounded by how much texture memory it's allowed to hold
+     *
+     * bengine::render_window runs its TTF_Font render_text functions through one of these, so text that gets drawn every frame (menus, labels, tooltips, etc) is only rendered through SDL_ttf once and then costs a single copy per frame
+     *
+     * Lookups hash the key in place and only compare against entries with the same hash, so a hit doesn't allocate anything
+     */
+    class text_cache {
+        private:
+            // \brief A rendered piece of text
+            struct entry {
+                // \brief The hash of the entry's key
+                Uint64 hash;
+                // \brief The font that the text was rendered with
+                TTF_Font *font;
+                // \brief The text that was rendered
+                std::u16string text;
+                // \brief The color that the text was rendered with (packed as 0xRRGGBBAA)
+                Uint32 color;
+                // \brief The width that the text was wrapped to (px) (0 for no wrapping)
+                Uint32 wrap_width;
+                // \brief The rendered text
+                SDL_Texture *texture;
+                // \brief The width of the texture (px)
+                int width;
+                // \brief The height of the texture (px)
+                int height;
+                // \brief Roughly how much memory the texture takes up (bytes)
+                std::size_t bytes;
+            };
+            // \brief Every cached entry, most recently used first
+            std::list<bengine::text_cache::entry> entries;
+            // \brief The entries keyed by their hash (entries that share a hash sit in the same vector)
+            std::unordered_map<Uint64, std::vector<std::list<bengine::text_cache::entry>::iterator>> lookup;
+
+            // \brief How much texture memory the cache is allowed to hold (bytes)
+            std::size_t budget = 16 * 1024 * 1024;
+            // \brief How much texture memory the cache is holding (bytes)
+            std::size_t used = 0;
+
+            // \brief How many lookups found their text already rendered
+            unsigned long long hits = 0;
+            // \brief How many lookups didn't find their text
+            unsigned long long misses = 0;
+            // \brief How many entries have been thrown out to stay under the budget
+            unsigned long long evictions = 0;
+
+            /** Pack an SDL_Color into a single number
+             * \param color The color to pack
+             * \returns The color as 0xRRGGBBAA
+             */
+            static Uint32 pack_color(const SDL_Color &color) {
+                return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) | (static_cast<Uint32>(color.b) << 8) | color.a;
+            }
+            /** Hash a key (FNV-1a)
+             * \param font The font
+             * \param text The text
+             * \param color The packed color
+             * \param wrap_width The wrap width
+             * \returns The hash of the key
+             */
+            static Uint64 hash_key(const TTF_Font *font, const char16_t *text, const Uint32 &color, const Uint32 &wrap_width) {
+                Uint64 output = 14695981039346656037ULL;
+                const auto mix = [&output](const Uint64 &value) {
+                    output ^= value;
+                    output *= 1099511628211ULL;
+                };
+                mix(reinterpret_cast<std::uintptr_t>(font));
+                mix(color);
+                mix(wrap_width);
+                for (const char16_t *character = text; *character != 0; character++) {
+                    mix(*character);
+                }
+                return output;
+            }
+            /** Find an entry
+             * \param hash The hash of the key
+             * \param font The font
+             * \param text The text
+             * \param color The packed color
+             * \param wrap_width The wrap width
+             * \returns The entry, or bengine::text_cache::entries.end() if there isn't one
+             */
+            std::list<bengine::text_cache::entry>::iterator find_entry(const Uint64 &hash, const TTF_Font *font, const char16_t *text, const Uint32 &color, const Uint32 &wrap_width) {
+                const auto bucket = this->lookup.find(hash);
+                if (bucket == this->lookup.end()) {
+                    return this->entries.end();
+                }
+                for (std::size_t i = 0; i < bucket->second.size(); i++) {
+                    const bengine::text_cache::entry &candidate = *bucket->second[i];
+                    if (candidate.font == font && candidate.color == color && candidate.wrap_width == wrap_width && candidate.text.compare(text) == 0) {
+                        return bucket->second[i];
+                    }
+                }
+                return this->entries.end();
+            }
+            /** Throw out an entry and destroy its texture
+             * \param position The entry to throw out
+             */
+            void erase(const std::list<bengine::text_cache::entry>::iterator &position) {
+                const auto bucket = this->lookup.find(position->hash);
+                if (bucket != this->lookup.end()) {
+                    for (std::size_t i = 0; i < bucket->second.size(); i++) {
+                        if (bucket->second[i] == position) {
+                            bucket->second.erase(bucket->second.begin() + i);
+                            break;
+                        }
+                    }
+                    if (bucket->second.empty()) {
+                        this->lookup.erase(bucket);
+                    }
+                }
+                SDL_DestroyTexture(position->texture);
+                this->used -= position->bytes;
+                this->entries.erase(position);
+            }
+            // \brief Throw out the least recently used entries until the cache is within its budget
+            void trim() {
+                while (this->used > this->budget && !this->entries.empty()) {
+                    this->erase(std::prev(this->entries.end()));
+                    this->evictions++;
+                }
+            }
+
+        public:
+            /** bengine::text_cache constructor
+             * \param budget How much texture memory the cache is allowed to hold (bytes) (0 to disable caching)
+             */
+            text_cache(const std::size_t &budget = 16 * 1024 * 1024) : budget(budget) {}
+            text_cache(const bengine::text_cache&) = delete;
+            bengine::text_cache& operator=(const bengine::text_cache&) = delete;
+            // \brief bengine::text_cache deconstructor; destroys every cached texture
+            ~text_cache() {
+                this->clear();
+            }
+
+            /** Look for text that has already been rendered, marking it as the most recently used if it's found
+             * \param font The font that the text was rendered with
+             * \param text The text
+             * \param color The color that the text was rendered with
+             * \param wrap_width The width that the text was wrapped to (px) (0 for no wrapping)
+             * \param width Where to store the width of the texture (px)
+             * \param height Where to store the height of the texture (px)
+             * \returns The rendered text, or NULL if it isn't cached (the cache keeps ownership of the texture)
+             */
+            SDL_Texture* find(const TTF_Font *font, const char16_t *text, const SDL_Color &color, const Uint32 &wrap_width, int &width, int &height) {
+                const Uint32 packed_color = bengine::text_cache::pack_color(color);
+                const auto position = this->find_entry(bengine::text_cache::hash_key(font, text, packed_color, wrap_width), font, text, packed_color, wrap_width);
+                if (position == this->entries.end()) {
+                    this->misses++;
+                    return NULL;
+                }
+                this->hits++;
+                this->entries.splice(this->entries.begin(), this->entries, position);
+                width = position->width;
+                height = position->height;
+                return position->texture;
+            }
+            /** Add rendered text to the cache, throwing out the least recently used entries if the cache goes over its budget
+             * \param font The font that the text was rendered with
+             * \param text The text
+             * \param color The color that the text was rendered with
+             * \param wrap_width The width that the text was wrapped to (px) (0 for no wrapping)
+             * \param texture The rendered text
+             * \param width The width of the texture (px)
+             * \param height The height of the texture (px)
+             * \returns Whether the texture was cached (the cache takes ownership of it if it was; it's left to the caller if it's too big for the budget)
+             */
+            bool insert(const TTF_Font *font, const char16_t *text, const SDL_Color &color, const Uint32 &wrap_width, SDL_Texture *texture, const int &width, const int &height) {
+                const std::size_t bytes = static_cast<std::size_t>(width) * height * 4;
+                if (texture == NULL || bytes > this->budget) {
+                    return false;
+                }
+
+                const Uint32 packed_color = bengine::text_cache::pack_color(color);
+                const Uint64 hash = bengine::text_cache::hash_key(font, text, packed_color, wrap_width);
+                const auto existing = this->find_entry(hash, font, text, packed_color, wrap_width);
+                if (existing != this->entries.end()) {
+                    this->erase(existing);
+                }
+
+                this->entries.push_front({hash, const_cast<TTF_Font*>(font), std::u16string(text), packed_color, wrap_width, texture, width, height, bytes});
+                this->lookup[hash].emplace_back(this->entries.begin());
+                this->used += bytes;
+                this->trim();
+                return true;
+            }
+            /** Throw out every entry rendered with a certain font (needed before closing a font, since a new font could be opened at the same address)
+             * \param font The font to forget
+             */
+            void forget_font(const TTF_Font *font) {
+                for (auto position = this->entries.begin(); position != this->entries.end();) {
+                    const auto next = std::next(position);
+                    if (position->font == font) {
+                        this->erase(position);
+                    }
+                    position = next;
+                }
+            }
+            // \brief Throw out every entry and destroy every cached texture
+            void clear() {
+                for (auto position = this->entries.begin(); position != this->entries.end(); position++) {
+                    SDL_DestroyTexture(position->texture);
+                }
+                this->entries.clear();
+                this->lookup.clear();
+                this->used = 0;
+            }
+
+            /** Get how much texture memory the cache is allowed to hold
+             * \returns How much texture memory the cache is allowed to hold (bytes)
+             */
+            std::size_t get_budget() const {
+                return this->budget;
+            }
+            /** Set how much texture memory the cache is allowed to hold, throwing out entries right away if it's now over
+             * \param budget How much texture memory the cache is allowed to hold (bytes) (0 to disable caching)
+             */
+            void set_budget(const std::size_t &budget) {
+                this->budget = budget;
+                this->trim();
+            }
+            /** Get roughly how much texture memory the cache is holding
+             * \returns Roughly how much texture memory the cache is holding (bytes)
+             */
+            std::size_t get_used() const {
+                return this->used;
+            }
+            /** Get how many pieces of text are cached
+             * \returns How many pieces of text are cached
+             */
+            std::size_t get_size() const {
+                return this->entries.size();
+            }
+            /** Get how many lookups found their text already rendered
+             * \returns How many lookups found their text already rendered
+             */
+            unsigned long long get_hits() const {
+                return this->hits;
+            }
+            /** Get how many lookups didn't find their text
+             * \returns How many lookups didn't find their text
+             */
+            unsigned long long get_misses() const {
+                return this->misses;
+            }
+            /** Get how many entries have been thrown out to stay under the budget
+             * \returns How many entries have been thrown out to stay under the budget
+             */
+            unsigned long long get_evictions() const {
+                return this->evictions;
+            }
+            // \brief Reset the hit, miss, and eviction counters
+            void reset_statistics() {
+                this->hits = 0;
+                this->misses = 0;
+                this->evictions = 0;
+            }
+    };
+}
+
+#endif // BENGINE_TEXT_CACHE_hpp
@@ -12,6 +12,8 @@ namespace bengine {
             SDL_Texture *source = nullptr;
             // \brief The portion of the source texture to actually display
             SDL_Rect frame = {};
+            // \brief Whether the source texture gets destroyed along with this (false for textures that are shared, like regions of a bengine::texture_atlas)
+            bool owns_source = true;
 
         public:
             /** bengine::basic_texture constructor
@@ -22,9 +24,23 @@ namespace bengine {
                 this->set_texture(texture);
                 this->set_frame(frame);
             }
+            /** bengine::basic_texture copy constructor; shares the source texture and copies its ownership the same way the assignment operator does
+             * \param rhs The bengine::basic_texture to copy
+             */
+            basic_texture(const bengine::basic_texture &rhs) {
+                *this = rhs;
+            }
+            /** bengine::basic_texture move constructor; takes over the source texture (and the responsibility for destroying it, if rhs had it)
+             * \param rhs The bengine::basic_texture to move from
+             */
+            basic_texture(bengine::basic_texture &&rhs) noexcept : source(rhs.source), frame(rhs.frame), owns_source(rhs.owns_source) {
+                rhs.owns_source = false;
+            }
             // \brief bengine::basic_texture deconstructor; pretty much just handles some SDL cleanup
             ~basic_texture() {
-                SDL_DestroyTexture(this->source);
+                if (this->owns_source) {
+                    SDL_DestroyTexture(this->source);
+                }
                 this->source = nullptr;
             }
 
@@ -33,6 +49,7 @@ namespace bengine {
              */
             void operator=(const bengine::basic_texture &rhs) {
                 this->set_texture(rhs.get_texture());
+                this->set_ownership(rhs.owns_texture());
                 this->set_frame(rhs.get_frame());
             }
 
@@ -48,6 +65,18 @@ namespace bengine {
             void set_texture(SDL_Texture *texture) {
                 this->source = texture;
             }
+            /** Get whether the source texture gets destroyed along with this
+             * \returns Whether the source texture gets destroyed along with this
+             */
+            bool owns_texture() const {
+                return this->owns_source;
+            }
+            /** Set whether the source texture gets destroyed along with this
+             * \param owns_source Whether the source texture should get destroyed along with this (false for textures that something else is responsible for)
+             */
+            void set_ownership(const bool &owns_source) {
+                this->owns_source = owns_source;
+            }
             /** Get the frame of the texture
              * \returns An SDL_Rect with the frame (NULL = entire texture)
              */
@@ -84,6 +113,10 @@ namespace bengine {
                 this->set_frame(frame);
                 this->set_color_mod(color_mod);
             }
+            /** bengine::modded_texture copy constructor; shares the source texture and copies its ownership the same way the assignment operator does
+             * \param rhs The bengine::modded_texture to copy
+             */
+            modded_texture(const bengine::modded_texture &rhs) : bengine::basic_texture(rhs), blend_mode(rhs.blend_mode), color_mod(rhs.color_mod) {}
             // \brief bengine::modded_texture deconstructor
             ~modded_texture() {
                 bengine::basic_texture::~basic_texture();
@@ -94,6 +127,7 @@ namespace bengine {
              */
             void operator=(const bengine::modded_texture &rhs) {
                 this->set_texture(rhs.get_texture());
+                this->set_ownership(rhs.owns_texture());
                 this->set_frame(rhs.get_frame());
                 this->set_color_mod(rhs.get_color_mod());
                 this->set_blend_mode(rhs.get_blend_mode());
@@ -213,6 +247,10 @@ namespace bengine {
                 this->set_pivot(pivot);
                 this->set_angle(angle);
             }
+            /** bengine::shifting_texture copy constructor; shares the source texture and copies its ownership the same way the assignment operator does
+             * \param rhs The bengine::shifting_texture to copy
+             */
+            shifting_texture(const bengine::shifting_texture &rhs) : bengine::modded_texture(rhs), pivot(rhs.pivot), angle(rhs.angle), flip(rhs.flip) {}
             // \brief bengine::shifting_texture deconstructor
             ~shifting_texture() {
                 bengine::modded_texture::~modded_texture();
@@ -223,6 +261,7 @@ namespace bengine {
              */
             void operator=(const bengine::shifting_texture &rhs) {
                 this->set_texture(rhs.get_texture());
+                this->set_ownership(rhs.owns_texture());
                 this->set_frame(rhs.get_frame());
                 this->set_color_mod(rhs.get_color_mod());
                 this->set_blend_mode(rhs.get_blend_mode());
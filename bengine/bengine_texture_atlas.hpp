@@ -0,0 +1,309 @@
+#ifndef BENGINE_TEXTURE_ATLAS_hpp
+#define BENGINE_TEXTURE_ATLAS_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bengine_texture.hpp"
+
+namespace bengine {
+    /** Packs many images (sprite sheets, tilesets, etc) into a few large textures at load time, so that everything drawn from the atlas can share a texture and end up in the same sprite batch
+     *
+     * Images are added by name and then packed all at once by bengine::render_window::build_texture_atlas, tallest first, with a skyline packer; images added after a build get packed into the space that's left over on the next one
+     *
+     * The pages belong to the renderer of the window that built the atlas, and need to be destroyed before that window is (declaring the atlas after the window, or as a member of a class derived from bengine::loop, takes care of that)
+     */
+    class texture_atlas {
+        private:
+            // \brief A segment of a page's skyline: the top edge of everything packed so far, from left to right
+            struct skyline_node {
+                // \brief Where the segment starts (px)
+                int x;
+                // \brief How far down the segment is (px)
+                int y;
+                // \brief How wide the segment is (px)
+                int width;
+            };
+            // \brief A texture that images are packed into
+            struct page {
+                // \brief The page's texture
+                SDL_Texture *texture;
+                // \brief The width of the texture (px)
+                int width;
+                // \brief The height of the texture (px)
+                int height;
+                // \brief The top edge of everything packed into the page so far
+                std::vector<bengine::texture_atlas::skyline_node> skyline;
+            };
+            // \brief Where an image ended up
+            struct region {
+                // \brief The page that the image is on
+                std::size_t page;
+                // \brief Where the image is on its page (px)
+                SDL_Rect frame;
+            };
+            // \brief An image waiting to be packed
+            struct pending_image {
+                // \brief The name that the image was added under
+                std::string name;
+                // \brief The image's pixels (ARGB8888)
+                SDL_Surface *surface;
+            };
+
+            // \brief The size of each page's sides (px), unless an image is too big to fit on one
+            int page_size;
+            // \brief How much empty space is left between packed images (px), so that filtering never bleeds neighbours in
+            int padding;
+            // \brief Every page that images have been packed into
+            std::vector<bengine::texture_atlas::page> pages;
+            // \brief Where every packed image ended up, keyed by name
+            std::unordered_map<std::string, bengine::texture_atlas::region> regions;
+            // \brief The images that have been added but not packed yet
+            std::vector<bengine::texture_atlas::pending_image> pending;
+
+            /** Find how high an image would have to sit to start at a certain skyline segment
+             * \param page The page to look in
+             * \param index The skyline segment that the image's left edge would line up with
+             * \param width The width of the image, including padding (px)
+             * \param height The height of the image, including padding (px)
+             * \returns The y-position that the image would be placed at, or -1 if it doesn't fit there
+             */
+            static int fit_at(const bengine::texture_atlas::page &page, const std::size_t &index, const int &width, const int &height) {
+                if (page.skyline[index].x + width > page.width) {
+                    return -1;
+                }
+                int y = page.skyline[index].y;
+                int remaining = width;
+                for (std::size_t i = index; remaining > 0; i++) {
+                    if (i >= page.skyline.size()) {
+                        return -1;
+                    }
+                    y = std::max(y, page.skyline[i].y);
+                    if (y + height > page.height) {
+                        return -1;
+                    }
+                    remaining -= page.skyline[i].width;
+                }
+                return y;
+            }
+            /** Find the spot on a page where an image's bottom edge would end up highest (breaking ties with the narrowest segment), and raise the skyline over it
+             * \param page The page to pack into
+             * \param width The width of the image, including padding (px)
+             * \param height The height of the image, including padding (px)
+             * \param x Where to store the x-position of the image (px)
+             * \param y Where to store the y-position of the image (px)
+             * \returns Whether the image fit on the page
+             */
+            static bool pack(bengine::texture_atlas::page &page, const int &width, const int &height, int &x, int &y) {
+                int best_bottom = INT_MAX, best_width = INT_MAX;
+                std::size_t best_index = page.skyline.size();
+                for (std::size_t i = 0; i < page.skyline.size(); i++) {
+                    const int fit_y = bengine::texture_atlas::fit_at(page, i, width, height);
+                    if (fit_y >= 0 && (fit_y + height < best_bottom || (fit_y + height == best_bottom && page.skyline[i].width < best_width))) {
+                        best_bottom = fit_y + height;
+                        best_width = page.skyline[i].width;
+                        best_index = i;
+                        x = page.skyline[i].x;
+                        y = fit_y;
+                    }
+                }
+                if (best_index == page.skyline.size()) {
+                    return false;
+                }
+
+                // The new segment covers the image, and whatever it overlaps to its right gets cut back or removed
+                page.skyline.insert(page.skyline.begin() + best_index, {x, y + height, width});
+                for (std::size_t i = best_index + 1; i < page.skyline.size();) {
+                    const int covered_until = page.skyline[i - 1].x + page.skyline[i - 1].width;
+                    if (page.skyline[i].x >= covered_until) {
+                        break;
+                    }
+                    const int overlap = covered_until - page.skyline[i].x;
+                    page.skyline[i].x += overlap;
+                    page.skyline[i].width -= overlap;
+                    if (page.skyline[i].width > 0) {
+                        break;
+                    }
+                    page.skyline.erase(page.skyline.begin() + i);
+                }
+                for (std::size_t i = 0; i + 1 < page.skyline.size();) {
+                    if (page.skyline[i].y == page.skyline[i + 1].y) {
+                        page.skyline[i].width += page.skyline[i + 1].width;
+                        page.skyline.erase(page.skyline.begin() + i + 1);
+                    } else {
+                        i++;
+                    }
+                }
+                return true;
+            }
+            /** Create a new, empty page
+             * \param renderer The renderer to create the page with
+             * \param width The width of the page (px)
+             * \param height The height of the page (px)
+             * \returns Whether the page was created
+             */
+            bool add_page(SDL_Renderer *renderer, const int &width, const int &height) {
+                SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height);
+                if (texture == NULL) {
+                    std::cout << "Failed to create a texture atlas page [bengine::texture_atlas::add_page]\nSDL Error: " << SDL_GetError() << "\n";
+                    return false;
+                }
+                // Static textures start out with whatever was in memory, so the page gets cleared to transparent once up front
+                const std::vector<Uint32> blank(static_cast<std::size_t>(width) * height, 0);
+                SDL_UpdateTexture(texture, NULL, blank.data(), width * static_cast<int>(sizeof(Uint32)));
+                SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+                this->pages.push_back({texture, width, height, {{0, 0, width}}});
+                return true;
+            }
+
+        public:
+            /** bengine::texture_atlas constructor
+             * \param page_size The size of each page's sides (px); images too big for a page get a page of their own
+             * \param padding How much empty space to leave between packed images (px)
+             */
+            texture_atlas(const int &page_size = 2048, const int &padding = 1) : page_size(page_size), padding(padding) {}
+            texture_atlas(const bengine::texture_atlas&) = delete;
+            bengine::texture_atlas& operator=(const bengine::texture_atlas&) = delete;
+            // \brief bengine::texture_atlas deconstructor; destroys every page and every image that wasn't packed
+            ~texture_atlas() {
+                this->clear();
+            }
+
+            /** Add an image to be packed by the next build (an image added under a name that's already in the atlas replaces it)
+             * \param name The name to get the image by
+             * \param surface The image (it's copied, so the caller still owns it)
+             * \returns Whether the image was added
+             */
+            bool add(const std::string &name, const SDL_Surface *surface) {
+                if (surface == NULL || surface->w <= 0 || surface->h <= 0) {
+                    return false;
+                }
+                SDL_Surface *converted = SDL_ConvertSurfaceFormat(const_cast<SDL_Surface*>(surface), SDL_PIXELFORMAT_ARGB8888, 0);
+                if (converted == NULL) {
+                    std::cout << "Failed to convert image \"" << name << "\" for the texture atlas [bengine::texture_atlas::add]\nSDL Error: " << SDL_GetError() << "\n";
+                    return false;
+                }
+                this->pending.push_back({name, converted});
+                return true;
+            }
+            /** Load an image to be packed by the next build (an image added under a name that's already in the atlas replaces it)
+             * \param name The name to get the image by
+             * \param filepath The path to the image
+             * \returns Whether the image was loaded
+             */
+            bool add(const std::string &name, const char *filepath) {
+                SDL_Surface *surface = IMG_Load(filepath);
+                if (surface == NULL) {
+                    std::cout << "Failed to load image \"" << filepath << "\" for the texture atlas [bengine::texture_atlas::add]\nSDL Error: " << SDL_GetError() << "\n";
+                    return false;
+                }
+                const bool output = this->add(name, surface);
+                SDL_FreeSurface(surface);
+                return output;
+            }
+
+            /** Pack every image that's been added since the last build into the pages, creating new pages as needed (use bengine::render_window::build_texture_atlas rather than calling this directly)
+             * \param renderer The renderer that the pages belong to (has to be the same one every time)
+             * \returns Whether every image was packed
+             */
+            bool build(SDL_Renderer *renderer) {
+                // Packing the tallest images first keeps the skyline flat, which wastes the least space
+                std::stable_sort(this->pending.begin(), this->pending.end(), [](const bengine::texture_atlas::pending_image &lhs, const bengine::texture_atlas::pending_image &rhs) {
+                    return lhs.surface->h != rhs.surface->h ? lhs.surface->h > rhs.surface->h : lhs.surface->w > rhs.surface->w;
+                });
+
+                bool output = true;
+                for (std::size_t i = 0; i < this->pending.size(); i++) {
+                    SDL_Surface *surface = this->pending[i].surface;
+                    const int width = surface->w + this->padding, height = surface->h + this->padding;
+                    int x = 0, y = 0;
+                    std::size_t page = 0;
+                    while (page < this->pages.size() && !bengine::texture_atlas::pack(this->pages[page], width, height, x, y)) {
+                        page++;
+                    }
+                    if (page == this->pages.size() && (!this->add_page(renderer, std::max(this->page_size, width), std::max(this->page_size, height)) || !bengine::texture_atlas::pack(this->pages.back(), width, height, x, y))) {
+                        output = false;
+                        SDL_FreeSurface(surface);
+                        continue;
+                    }
+
+                    const SDL_Rect frame = {x, y, surface->w, surface->h};
+                    if (SDL_UpdateTexture(this->pages[page].texture, &frame, surface->pixels, surface->pitch) != 0) {
+                        std::cout << "Failed to copy image \"" << this->pending[i].name << "\" into the texture atlas [bengine::texture_atlas::build]\nSDL Error: " << SDL_GetError() << "\n";
+                        output = false;
+                    } else {
+                        this->regions[this->pending[i].name] = {page, frame};
+                    }
+                    SDL_FreeSurface(surface);
+                }
+                this->pending.clear();
+                return output;
+            }
+            // \brief Destroy every page and every image that wasn't packed
+            void clear() {
+                for (std::size_t i = 0; i < this->pages.size(); i++) {
+                    SDL_DestroyTexture(this->pages[i].texture);
+                }
+                for (std::size_t i = 0; i < this->pending.size(); i++) {
+                    SDL_FreeSurface(this->pending[i].surface);
+                }
+                this->pages.clear();
+                this->regions.clear();
+                this->pending.clear();
+            }
+
+            /** Check whether an image has been packed
+             * \param name The name that the image was added under
+             * \returns Whether the image has been packed
+             */
+            bool has(const std::string &name) const {
+                return this->regions.find(name) != this->regions.end();
+            }
+            /** Get a packed image as a texture whose frame is its place on its page (the texture doesn't own the page, so it can be copied around and destroyed freely)
+             * \param name The name that the image was added under
+             * \returns The packed image (with no source texture if there isn't one by that name)
+             */
+            bengine::basic_texture get(const std::string &name) const {
+                bengine::basic_texture output(this->get_page(name), this->get_frame(name));
+                output.set_ownership(false);
+                return output;
+            }
+            /** Get the page that a packed image is on
+             * \param name The name that the image was added under
+             * \returns The page that the image is on, or NULL if there isn't one by that name
+             */
+            SDL_Texture* get_page(const std::string &name) const {
+                const auto position = this->regions.find(name);
+                return position == this->regions.end() ? NULL : this->pages[position->second.page].texture;
+            }
+            /** Get where a packed image is on its page
+             * \param name The name that the image was added under
+             * \returns Where the image is on its page (px for all 4 metrics), or an empty rectangle if there isn't one by that name
+             */
+            SDL_Rect get_frame(const std::string &name) const {
+                const auto position = this->regions.find(name);
+                return position == this->regions.end() ? SDL_Rect{0, 0, 0, 0} : position->second.frame;
+            }
+            /** Get how many pages the atlas has
+             * \returns How many pages the atlas has
+             */
+            std::size_t get_page_count() const {
+                return this->pages.size();
+            }
+            /** Get how many images have been packed
+             * \returns How many images have been packed
+             */
+            std::size_t get_size() const {
+                return this->regions.size();
+            }
+    };
+}
+
+#endif // BENGINE_TEXTURE_ATLAS_hpp
@@ -0,0 +1,311 @@
+#ifndef BENGINE_TEXTURE_LOADER_hpp
+#define BENGINE_TEXTURE_LOADER_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bengine_clock.hpp"
+#include "bengine_job_system.hpp"
+
+namespace bengine {
+    /** Loads textures without stalling the render thread: image files are read and decoded into surfaces on a bengine::job_system, and the surfaces are turned into textures a few at a time by bengine::render_window::upload_textures, which only spends a fixed slice of each frame on it
+     *
+     * Requesting a texture hands back a handle right away; until the texture is ready bengine::texture_loader::get_texture returns a placeholder (a magenta and black checkerboard unless another one is set), so scenes can draw as if everything were already loaded
+     *
+     * bengine::loop owns one of these that runs on its job system and gets uploaded every frame; the textures belong to the renderer that uploaded them and the loader has to be destroyed before the job system is
+     *
+     * Textures can be requested, checked on, and released from any thread (like the simulation thread of a bengine::threaded_loop), but uploading and anything that hands out an SDL_Texture has to stay on the render thread
+     */
+    class texture_loader {
+        public:
+            // \brief How far along a requested texture is
+            enum class load_state {
+                DECODING,
+                UPLOADING,
+                READY,
+                FAILED
+            };
+
+        private:
+            // \brief A requested texture
+            struct entry {
+                // \brief The path that the texture is loaded from
+                std::string filepath;
+                // \brief How far along the texture is
+                bengine::texture_loader::load_state state;
+                // \brief The texture (NULL until it's ready)
+                SDL_Texture *texture;
+            };
+            // \brief An image that a worker has finished decoding
+            struct decoded_image {
+                // \brief The handle of the texture that the image is for
+                unsigned int id;
+                // \brief The decoded image (NULL if it couldn't be loaded)
+                SDL_Surface *surface;
+                // \brief Why the image couldn't be loaded (SDL's error string is per-thread, so it has to be copied on the worker)
+                std::string error;
+            };
+
+            // \brief The job system that images are decoded on
+            bengine::job_system &jobs;
+            // \brief Counts the images that are still being decoded
+            bengine::job_counter decodes;
+            // \brief Guards bengine::texture_loader::decoded
+            std::mutex decoded_mutex;
+            // \brief Images that workers have finished decoding and that haven't been picked up by the render thread yet
+            std::vector<bengine::texture_loader::decoded_image> decoded;
+            // \brief Decoded images waiting for their turn to be uploaded (only touched by the render thread)
+            std::deque<bengine::texture_loader::decoded_image> uploads;
+            // \brief Guards bengine::texture_loader::entries and bengine::texture_loader::next_id (always locked before bengine::texture_loader::decoded_mutex when both are needed)
+            mutable std::mutex entries_mutex;
+            // \brief Every requested texture keyed by handle
+            std::unordered_map<unsigned int, bengine::texture_loader::entry> entries;
+            // \brief The handle that the next requested texture will get
+            unsigned int next_id = 1;
+            // \brief Textures that were released and are waiting to be destroyed on the render thread
+            std::vector<SDL_Texture*> released;
+
+            // \brief How much time bengine::texture_loader::upload gets each call (seconds); at least one texture is always uploaded so loading can't stall
+            double upload_budget = 0.002;
+            // \brief What gets drawn in place of textures that aren't ready
+            SDL_Texture *placeholder = NULL;
+            // \brief The default checkerboard placeholder (made the first time textures are uploaded)
+            SDL_Texture *default_placeholder = NULL;
+
+            /** Make the default checkerboard placeholder
+             * \param renderer The renderer to make it with
+             */
+            void create_default_placeholder(SDL_Renderer *renderer) {
+                // A 2x2 checkerboard scaled up with nearest-neighbour filtering is impossible to mistake for a real texture
+                const Uint32 pixels[4] = {0xFFFF00FF, 0xFF000000, 0xFF000000, 0xFFFF00FF};
+                if ((this->default_placeholder = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 2, 2)) == NULL) {
+                    std::cout << "Failed to create the placeholder texture [bengine::texture_loader::create_default_placeholder]\nSDL Error: " << SDL_GetError() << "\n";
+                    return;
+                }
+                SDL_UpdateTexture(this->default_placeholder, NULL, pixels, 2 * static_cast<int>(sizeof(Uint32)));
+            }
+
+        public:
+            /** bengine::texture_loader constructor
+             * \param jobs The job system to decode images on
+             */
+            texture_loader(bengine::job_system &jobs) : jobs(jobs) {}
+            texture_loader(const bengine::texture_loader&) = delete;
+            bengine::texture_loader& operator=(const bengine::texture_loader&) = delete;
+            // \brief bengine::texture_loader deconstructor; waits for any images still being decoded and then destroys every texture it loaded
+            ~texture_loader() {
+                this->clear();
+            }
+
+            // \brief Wait for any images still being decoded, then destroy every texture that was loaded (including the default placeholder) and forget every handle; this has to happen before SDL is shut down
+            void clear() {
+                this->jobs.wait(this->decodes);
+                std::lock_guard<std::mutex> entries_lock(this->entries_mutex);
+                std::lock_guard<std::mutex> decoded_lock(this->decoded_mutex);
+                for (std::size_t i = 0; i < this->decoded.size(); i++) {
+                    SDL_FreeSurface(this->decoded[i].surface);
+                }
+                this->decoded.clear();
+                for (std::size_t i = 0; i < this->uploads.size(); i++) {
+                    SDL_FreeSurface(this->uploads[i].surface);
+                }
+                this->uploads.clear();
+                for (auto position = this->entries.begin(); position != this->entries.end(); position++) {
+                    SDL_DestroyTexture(position->second.texture);
+                }
+                this->entries.clear();
+                for (std::size_t i = 0; i < this->released.size(); i++) {
+                    SDL_DestroyTexture(this->released[i]);
+                }
+                this->released.clear();
+                SDL_DestroyTexture(this->default_placeholder);
+                this->default_placeholder = NULL;
+            }
+
+            /** Start loading a texture in the background
+             * \param filepath The path to the image
+             * \returns A handle for the texture
+             */
+            unsigned int request(const std::string &filepath) {
+                unsigned int id;
+                {
+                    std::lock_guard<std::mutex> lock(this->entries_mutex);
+                    id = this->next_id++;
+                    this->entries[id] = {filepath, bengine::texture_loader::load_state::DECODING, NULL};
+                }
+                this->jobs.submit(this->decodes, [this, id, filepath]() {
+                    bengine::texture_loader::decoded_image output = {id, IMG_Load(filepath.c_str()), ""};
+                    // Converting here saves SDL_CreateTextureFromSurface from doing it on the render thread
+                    if (output.surface != NULL && output.surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+                        SDL_Surface *converted = SDL_ConvertSurfaceFormat(output.surface, SDL_PIXELFORMAT_ARGB8888, 0);
+                        SDL_FreeSurface(output.surface);
+                        output.surface = converted;
+                    }
+                    if (output.surface == NULL) {
+                        output.error = SDL_GetError();
+                    }
+                    std::lock_guard<std::mutex> lock(this->decoded_mutex);
+                    this->decoded.emplace_back(output);
+                });
+                return id;
+            }
+            /** Turn decoded images into textures until the upload budget runs out (use bengine::render_window::upload_textures rather than calling this directly; it has to happen on the render thread)
+             * \param renderer The renderer that the textures belong to (has to be the same one every time)
+             * \returns How many textures became ready
+             */
+            std::size_t upload(SDL_Renderer *renderer) {
+                if (this->default_placeholder == NULL) {
+                    this->create_default_placeholder(renderer);
+                }
+                // Without any workers nothing would ever decode the images, so they get decoded here instead
+                if (this->jobs.get_worker_count() == 0 && !this->decodes.is_done()) {
+                    this->jobs.wait(this->decodes);
+                }
+                {
+                    std::lock_guard<std::mutex> entries_lock(this->entries_mutex);
+                    for (std::size_t i = 0; i < this->released.size(); i++) {
+                        SDL_DestroyTexture(this->released[i]);
+                    }
+                    this->released.clear();
+
+                    std::lock_guard<std::mutex> decoded_lock(this->decoded_mutex);
+                    for (std::size_t i = 0; i < this->decoded.size(); i++) {
+                        const auto position = this->entries.find(this->decoded[i].id);
+                        if (position == this->entries.end()) {
+                            SDL_FreeSurface(this->decoded[i].surface);
+                            continue;
+                        }
+                        position->second.state = bengine::texture_loader::load_state::UPLOADING;
+                        this->uploads.emplace_back(std::move(this->decoded[i]));
+                    }
+                    this->decoded.clear();
+                }
+
+                std::size_t output = 0;
+                const Uint64 start = bengine::precision_clock::now();
+                while (!this->uploads.empty() && (output == 0 || bengine::precision_clock::seconds_since(start) < this->upload_budget)) {
+                    const bengine::texture_loader::decoded_image current = std::move(this->uploads.front());
+                    this->uploads.pop_front();
+                    std::lock_guard<std::mutex> lock(this->entries_mutex);
+                    const auto position = this->entries.find(current.id);
+                    if (position == this->entries.end()) {
+                        SDL_FreeSurface(current.surface);
+                        continue;
+                    }
+
+                    if (current.surface == NULL) {
+                        std::cout << "Failed to load texture \"" << position->second.filepath << "\" [bengine::texture_loader::upload]\nSDL Error: " << current.error << "\n";
+                        position->second.state = bengine::texture_loader::load_state::FAILED;
+                        continue;
+                    }
+                    position->second.texture = SDL_CreateTextureFromSurface(renderer, current.surface);
+                    SDL_FreeSurface(current.surface);
+                    if (position->second.texture == NULL) {
+                        std::cout << "Failed to upload texture \"" << position->second.filepath << "\" [bengine::texture_loader::upload]\nSDL Error: " << SDL_GetError() << "\n";
+                        position->second.state = bengine::texture_loader::load_state::FAILED;
+                        continue;
+                    }
+                    position->second.state = bengine::texture_loader::load_state::READY;
+                    output++;
+                }
+                return output;
+            }
+
+            /** Get a requested texture, or the placeholder if it isn't ready (or failed to load)
+             * \param id The handle returned by bengine::texture_loader::request
+             * \returns The texture or the placeholder (the loader keeps ownership of both)
+             */
+            SDL_Texture* get_texture(const unsigned int &id) const {
+                std::lock_guard<std::mutex> lock(this->entries_mutex);
+                const auto position = this->entries.find(id);
+                if (position != this->entries.end() && position->second.texture != NULL) {
+                    return position->second.texture;
+                }
+                return this->placeholder != NULL ? this->placeholder : this->default_placeholder;
+            }
+            /** Get how far along a requested texture is
+             * \param id The handle returned by bengine::texture_loader::request
+             * \returns How far along the texture is (FAILED if there isn't one with that handle)
+             */
+            bengine::texture_loader::load_state get_state(const unsigned int &id) const {
+                std::lock_guard<std::mutex> lock(this->entries_mutex);
+                const auto position = this->entries.find(id);
+                return position == this->entries.end() ? bengine::texture_loader::load_state::FAILED : position->second.state;
+            }
+            /** Check whether a requested texture is ready to be drawn
+             * \param id The handle returned by bengine::texture_loader::request
+             * \returns Whether the texture is ready
+             */
+            bool is_ready(const unsigned int &id) const {
+                return this->get_state(id) == bengine::texture_loader::load_state::READY;
+            }
+            /** Check whether any requested textures are still being decoded or waiting to be uploaded
+             * \returns Whether any requested textures are still loading
+             */
+            bool is_busy() const {
+                std::lock_guard<std::mutex> lock(this->entries_mutex);
+                for (auto position = this->entries.begin(); position != this->entries.end(); position++) {
+                    if (position->second.state == bengine::texture_loader::load_state::DECODING || position->second.state == bengine::texture_loader::load_state::UPLOADING) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /** Take a ready texture out of the loader so that something else can own it (like a bengine::basic_texture)
+             * \param id The handle returned by bengine::texture_loader::request
+             * \returns The texture (the caller owns it now), or NULL if it isn't ready
+             */
+            SDL_Texture* detach(const unsigned int &id) {
+                std::lock_guard<std::mutex> lock(this->entries_mutex);
+                const auto position = this->entries.find(id);
+                if (position == this->entries.end() || position->second.texture == NULL) {
+                    return NULL;
+                }
+                SDL_Texture *output = position->second.texture;
+                this->entries.erase(position);
+                return output;
+            }
+            /** Forget a requested texture; if it's been loaded it gets destroyed the next time textures are uploaded, and a texture that's still decoding gets thrown out once it's done
+             * \param id The handle returned by bengine::texture_loader::request
+             */
+            void release(const unsigned int &id) {
+                std::lock_guard<std::mutex> lock(this->entries_mutex);
+                const auto position = this->entries.find(id);
+                if (position == this->entries.end()) {
+                    return;
+                }
+                if (position->second.texture != NULL) {
+                    this->released.emplace_back(position->second.texture);
+                }
+                this->entries.erase(position);
+            }
+
+            /** Set what gets drawn in place of textures that aren't ready
+             * \param placeholder The placeholder (the caller keeps ownership of it) (NULL for the default checkerboard)
+             */
+            void set_placeholder(SDL_Texture *placeholder) {
+                this->placeholder = placeholder;
+            }
+            /** Get how much time each upload gets
+             * \returns How much time each upload gets (seconds)
+             */
+            double get_upload_budget() const {
+                return this->upload_budget;
+            }
+            /** Set how much time each upload gets (at least one texture is always uploaded regardless)
+             * \param budget How much time each upload gets (seconds)
+             */
+            void set_upload_budget(const double &budget) {
+                this->upload_budget = budget;
+            }
+    };
+}
+
+#endif // BENGINE_TEXTURE_LOADER_hpp
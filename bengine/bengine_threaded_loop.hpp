@@ -0,0 +1,185 @@
+#ifndef BENGINE_THREADED_LOOP_hpp
+#define BENGINE_THREADED_LOOP_hpp
+
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bengine_loop.hpp"
+#include "bengine_triple_buffer.hpp"
+
+namespace bengine {
+    /** A version of bengine::loop that runs handle_event() and compute() on a dedicated simulation thread at the fixed tick rate while the main thread only polls SDL events, renders, and presents
+     *
+     * Everything that render() needs has to be copied into a snapshot by publish(), which runs on the simulation thread whenever visuals_changed is set; render() should only read from get_snapshot() (and the window) since the rest of the subclass's state belongs to the simulation thread
+     *
+     * \tparam snapshot_type A default-constructible, copy-assignable type holding all of the render-relevant state
+     */
+    template <class snapshot_type> class threaded_loop : public bengine::loop {
+        private:
+            // \brief The snapshots handed from the simulation thread to the main thread
+            bengine::triple_buffer<snapshot_type> snapshots;
+
+            // \brief Guards bengine::threaded_loop::pending_events, bengine::threaded_loop::pending_keystate, and the pending mouse state
+            std::mutex input_mutex;
+            // \brief Events that the main thread has polled, but the simulation thread hasn't processed yet
+            std::vector<SDL_Event> pending_events;
+            // \brief The keyboard state as of the most recent poll on the main thread
+            Uint8 pending_keystate[SDL_NUM_SCANCODES] = {};
+            // \brief The mouse's x-position relative to the window as of the most recent poll on the main thread (px)
+            int pending_mouse_x = 0;
+            // \brief The mouse's y-position relative to the window as of the most recent poll on the main thread (px)
+            int pending_mouse_y = 0;
+            // \brief The mouse button bitmask as of the most recent poll on the main thread
+            Uint32 pending_mouse_buttons = 0;
+            // \brief The events being processed by the simulation thread (kept around so its memory is reused)
+            std::vector<SDL_Event> simulation_events;
+            // \brief The copy of the keyboard state that bengine::loop::keystate points at for the simulation thread
+            Uint8 simulation_keystate[SDL_NUM_SCANCODES] = {};
+
+            // \brief The body of the simulation thread
+            void run_simulation() {
+                Uint64 current_time = bengine::precision_clock::now();
+                Uint64 new_time = 0;
+                double simulation_frame_duration = 0.0;
+                double accumulator = 0.0;
+
+                this->simulation_limiter.reset();
+                while (this->loop_running) {
+                    new_time = bengine::precision_clock::now();
+                    simulation_frame_duration = bengine::precision_clock::seconds_between(current_time, new_time);
+                    current_time = new_time;
+                    accumulator += simulation_frame_duration;
+
+                    this->poll_events();
+                    this->simulate(accumulator);
+                    // Once-per-frame subsystems run once per pass of the simulation thread since that's where the rest of the simulation state lives
+                    this->subsystems.frame(simulation_frame_duration);
+                    this->work_duration = this->sliced_work.run();
+
+                    this->interpolation_factor = std::min(accumulator / this->delta_time, 1.0);
+                    if (this->visuals_changed) {
+                        this->visuals_changed = false;
+                        this->publish(this->snapshots.get_write_buffer());
+                        this->snapshots.publish();
+                    }
+
+                    this->simulation_limiter.set_target_frame_time(this->delta_time);
+                    this->simulation_limiter.wait();
+                }
+            }
+
+        protected:
+            // \brief The frame limiter used to pace the simulation thread; its target always follows bengine::loop::delta_time
+            bengine::frame_limiter simulation_limiter;
+
+            /** A virtual function that will be called on the simulation thread whenever visuals_changed is set to copy everything render() needs into a snapshot
+             * \param snapshot The snapshot to fill; it may hold stale data from a few publishes ago, so everything in it should be overwritten
+             */
+            virtual void publish(snapshot_type &snapshot) = 0;
+            /** Get the most recent snapshot (main thread only; intended for use within render())
+             * \returns The most recent snapshot
+             */
+            const snapshot_type& get_snapshot() const {
+                return this->snapshots.get_read_buffer();
+            }
+
+            // \brief Take every event that the main thread has polled since the simulation thread's last pass and dispatch them, along with the keyboard and mouse state from that poll (simulation thread only)
+            void poll_events() override {
+                {
+                    std::lock_guard<std::mutex> lock(this->input_mutex);
+                    this->simulation_events.swap(this->pending_events);
+                    std::memcpy(this->simulation_keystate, this->pending_keystate, SDL_NUM_SCANCODES);
+                    this->mouse_x = this->pending_mouse_x;
+                    this->mouse_y = this->pending_mouse_y;
+                    this->mouse_buttons = this->pending_mouse_buttons;
+                }
+                for (std::size_t i = 0; i < this->simulation_events.size(); i++) {
+                    this->event = this->simulation_events[i];
+                    this->dispatch_event();
+                }
+                this->simulation_events.clear();
+            }
+
+        public:
+            /** bengine::threaded_loop constructor; mainly creates the window that will be used
+             * \param title The title of the window being created
+             * \param width The width of the window being created
+             * \param height The height of the window being created
+             * \param flags SDL2 flags to create the window with
+             * \param image_init_flags SDL2 image flags to initialize SDL_image with (-1 to not initialize)
+             * \param use_TTF Whether to initialize SDL_ttf or not
+             * \param headless Whether to run without a window or the SDL video subsystem; like with bengine::loop, render() isn't called unless bengine::loop::render_while_headless is set, and the window draws into an offscreen surface instead
+             */
+            threaded_loop(const char* title = "window", const Uint16 &width = 1920, const Uint16 &height = 1080, const Uint32 &flags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE, const int &image_init_flags = IMG_INIT_PNG, const bool &use_TTF = true, const bool &headless = false) : bengine::loop(title, width, height, flags, image_init_flags, use_TTF, headless) {
+                this->keystate = this->simulation_keystate;
+            }
+            // \brief bengine::threaded_loop deconstructor
+            ~threaded_loop() {}
+
+            /** The main function that handles the looping behavior; spawns the simulation thread and then polls, renders, and presents on the calling thread until the loop stops
+             * \returns 0 (anything additional hasn't been added yet)
+             */
+            int run() override {
+                Uint64 current_time = bengine::precision_clock::now();
+                Uint64 new_time = 0;
+                SDL_Event polled_event;
+                bool window_changed = true;
+
+                // The first snapshot is published before the simulation thread exists so that render() always has something valid to read
+                this->publish(this->snapshots.get_write_buffer());
+                this->snapshots.publish();
+                this->visuals_changed = false;
+
+                std::thread simulation_thread(&bengine::threaded_loop<snapshot_type>::run_simulation, this);
+
+                this->limiter.reset();
+                while (this->loop_running) {
+                    if (this->limit_to_refresh_rate) {
+                        this->limiter.set_target_rate(this->window.get_refresh_rate());
+                    }
+
+                    new_time = bengine::precision_clock::now();
+                    this->frame_duration = bengine::precision_clock::seconds_between(current_time, new_time);
+                    current_time = new_time;
+
+                    {
+                        std::lock_guard<std::mutex> lock(this->input_mutex);
+                        while (SDL_PollEvent(&polled_event)) {
+                            switch (polled_event.type) {
+                                case SDL_QUIT:
+                                    this->loop_running = false;
+                                    break;
+                                case SDL_WINDOWEVENT:
+                                    this->window.handle_event(polled_event.window);
+                                    window_changed = true;
+                                    break;
+                            }
+                            this->pending_events.emplace_back(polled_event);
+                        }
+                        std::memcpy(this->pending_keystate, SDL_GetKeyboardState(NULL), SDL_NUM_SCANCODES);
+                        this->pending_mouse_buttons = SDL_GetMouseState(&this->pending_mouse_x, &this->pending_mouse_y);
+                    }
+
+                    this->render_duration = 0.0;
+                    if (this->window.upload_textures(this->texture_loads) > 0) {
+                        window_changed = true;
+                    }
+                    if (this->snapshots.update() || window_changed) {
+                        window_changed = false;
+                        if (!this->is_headless() || this->render_while_headless) {
+                            this->render_frame();
+                        }
+                    }
+
+                    this->limiter.wait();
+                }
+
+                simulation_thread.join();
+                return 0;
+            }
+    };
+}
+
+#endif // BENGINE_THREADED_LOOP_hpp
@@ -0,0 +1,82 @@
+#ifndef BENGINE_TRIPLE_BUFFER_hpp
+#define BENGINE_TRIPLE_BUFFER_hpp
+
+#include <atomic>
+
+namespace bengine {
+    /** A lock-free triple buffer for handing whole values from one writing thread to one reading thread
+     *
+     * The writer always has a buffer of its own to fill, the reader always has a buffer of its own to read, and the third buffer sits in the middle holding the most recently published value; neither side ever waits on the other and the reader always sees the newest complete value
+     *
+     * \tparam type Any default-constructible, copy-assignable type
+     */
+    template <class type> class triple_buffer {
+        private:
+            // \brief The bit of bengine::triple_buffer::middle that marks whether the middle buffer holds a value that the reader hasn't picked up yet
+            static const unsigned char fresh_bit = 4;
+            // \brief The bits of bengine::triple_buffer::middle that hold the index of the middle buffer
+            static const unsigned char index_bits = 3;
+
+            // \brief The three buffers
+            type buffers[3];
+            // \brief The index of the middle buffer combined with the fresh bit; the only thing that is shared between the two threads
+            std::atomic<unsigned char> middle = 1;
+            // \brief The index of the buffer that belongs to the writer (only ever touched by the writing thread)
+            unsigned char write_index = 0;
+            // \brief The index of the buffer that belongs to the reader (only ever touched by the reading thread)
+            unsigned char read_index = 2;
+
+        public:
+            // \brief bengine::triple_buffer constructor
+            triple_buffer() {}
+            /** bengine::triple_buffer constructor
+             * \param initial_value The value to start all three buffers with
+             */
+            triple_buffer(const type &initial_value) {
+                for (unsigned char i = 0; i < 3; i++) {
+                    this->buffers[i] = initial_value;
+                }
+            }
+            // \brief bengine::triple_buffer deconstructor
+            ~triple_buffer() {}
+
+            /** Get the buffer that the writer should fill (writing thread only)
+             *
+             * The buffer that comes back might hold an older value rather than the most recently published one, so it should be completely overwritten before publishing
+             *
+             * \returns The writer's buffer
+             */
+            type& get_write_buffer() {
+                return this->buffers[this->write_index];
+            }
+            // \brief Publish the writer's buffer so that the reader can pick it up, and take the old middle buffer as the next one to write to (writing thread only)
+            void publish() {
+                this->write_index = this->middle.exchange(this->write_index | bengine::triple_buffer<type>::fresh_bit, std::memory_order_acq_rel) & bengine::triple_buffer<type>::index_bits;
+            }
+
+            /** Check whether a value has been published that the reader hasn't picked up yet (safe from either thread)
+             * \returns Whether a value has been published that the reader hasn't picked up yet
+             */
+            bool has_update() const {
+                return (this->middle.load(std::memory_order_acquire) & bengine::triple_buffer<type>::fresh_bit) != 0;
+            }
+            /** Pick up the most recently published value if there is one (reading thread only)
+             * \returns Whether a new value was picked up
+             */
+            bool update() {
+                if (!this->has_update()) {
+                    return false;
+                }
+                this->read_index = this->middle.exchange(this->read_index, std::memory_order_acq_rel) & bengine::triple_buffer<type>::index_bits;
+                return true;
+            }
+            /** Get the buffer that the reader is currently holding (reading thread only)
+             * \returns The reader's buffer
+             */
+            const type& get_read_buffer() const {
+                return this->buffers[this->read_index];
+            }
+    };
+}
+
+#endif // BENGINE_TRIPLE_BUFFER_hpp
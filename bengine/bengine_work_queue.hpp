@@ -0,0 +1,215 @@
+#ifndef BENGINE_WORK_QUEUE_hpp
+#define BENGINE_WORK_QUEUE_hpp
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "bengine_clock.hpp"
+
+namespace bengine {
+    /** A queue of resumable tasks that only gets a fixed slice of time each frame, for work that is too big to finish in one frame but doesn't have to (regenerating a large texture, repopulating a big grid, precomputing paths, etc)
+     *
+     * A task is a function that does one small chunk of its work each time it's called and returns true once it's finished; the queue keeps calling tasks until the frame's budget runs out, so chunks should be small compared to the budget since the queue can only stop between them
+     *
+     * Higher priority tasks go first and tasks of the same priority go first-come-first-served, but any task that has gone too many frames without running gets a chunk at the start of the next frame regardless of priority or budget so that low priority work always makes progress
+     */
+    class work_queue {
+        private:
+            // \brief A task along with the bookkeeping needed to schedule it
+            struct entry {
+                // \brief Does one chunk of the work and returns whether the task is finished
+                std::function<bool()> step;
+                // \brief The task's priority (higher goes first)
+                int priority;
+                // \brief The task's handle; also gives the order that tasks were pushed in
+                unsigned long long id;
+                // \brief The frame that the task last got to run during (or was pushed during)
+                unsigned long long last_frame;
+                // \brief Whether the task was cancelled while a task was running (it gets removed once that task's chunk is done)
+                bool cancelled;
+            };
+
+            // \brief Every unfinished task (a deque so that tasks can push more tasks while they're running without moving themselves)
+            std::deque<bengine::work_queue::entry> entries;
+            // \brief The handle that the next pushed task will get
+            unsigned long long next_id = 1;
+            // \brief How many times bengine::work_queue::run has been called
+            unsigned long long frame = 0;
+
+            // \brief How much time the queue gets each frame (seconds)
+            double budget = 0.002;
+            // \brief How many frames a task can go without running before it's treated as starving (0 to disable starvation protection)
+            unsigned int starvation_limit = 30;
+
+            // \brief How many chunks were run during the most recent frame
+            unsigned int steps_run = 0;
+            // \brief Whether a task's chunk is currently running (cancelling then only marks tasks so the running one isn't destroyed mid-call)
+            bool stepping = false;
+
+            /** Check whether a task has gone too long without running
+             * \param entry The task to check
+             * \returns Whether the task is starving
+             */
+            bool is_starving(const bengine::work_queue::entry &entry) const {
+                return this->starvation_limit > 0 && this->frame - entry.last_frame > this->starvation_limit;
+            }
+            /** Run a single chunk of a task
+             * \param index The index of the task in bengine::work_queue::entries
+             * \returns Whether the task finished (and was removed)
+             */
+            bool step(const std::size_t &index) {
+                this->entries[index].last_frame = this->frame;
+                this->steps_run++;
+                this->stepping = true;
+                // Nothing gets erased while the chunk runs, so index still points at the same task afterwards
+                const bool finished = this->entries[index].step();
+                this->stepping = false;
+                if (finished) {
+                    this->entries[index].cancelled = true;
+                }
+                this->remove_cancelled();
+                return finished;
+            }
+            // \brief Remove every task that was cancelled while a chunk was running
+            void remove_cancelled() {
+                this->entries.erase(std::remove_if(this->entries.begin(), this->entries.end(), [](const bengine::work_queue::entry &entry) {
+                    return entry.cancelled;
+                }), this->entries.end());
+            }
+
+        public:
+            /** bengine::work_queue constructor
+             * \param budget How much time the queue gets each frame (seconds)
+             * \param starvation_limit How many frames a task can go without running before it gets a guaranteed chunk (0 to disable starvation protection)
+             */
+            work_queue(const double &budget = 0.002, const unsigned int &starvation_limit = 30) : budget(budget), starvation_limit(starvation_limit) {}
+            // \brief bengine::work_queue deconstructor
+            ~work_queue() {}
+
+            /** Add a task to the queue
+             * \param step A function that does one chunk of the work each time it's called and returns true once the work is finished
+             * \param priority The task's priority (higher goes first)
+             * \returns A handle that can be used to cancel the task
+             */
+            unsigned long long push(const std::function<bool()> &step, const int &priority = 0) {
+                this->entries.push_back({step, priority, this->next_id, this->frame, false});
+                return this->next_id++;
+            }
+            /** Remove a task before it finishes (safe to call from inside a task; the task is then removed once the running chunk is done)
+             * \param id The handle returned by bengine::work_queue::push
+             * \returns Whether the task was found (false if it already finished or was already cancelled)
+             */
+            bool cancel(const unsigned long long &id) {
+                for (std::size_t i = 0; i < this->entries.size(); i++) {
+                    if (this->entries[i].id == id && !this->entries[i].cancelled) {
+                        if (this->stepping) {
+                            this->entries[i].cancelled = true;
+                        } else {
+                            this->entries.erase(this->entries.begin() + i);
+                        }
+                        return true;
+                    }
+                }
+                return false;
+            }
+            // \brief Remove every task (safe to call from inside a task)
+            void clear() {
+                if (this->stepping) {
+                    for (std::size_t i = 0; i < this->entries.size(); i++) {
+                        this->entries[i].cancelled = true;
+                    }
+                    return;
+                }
+                this->entries.clear();
+            }
+
+            /** Get how much time the queue gets each frame
+             * \returns How much time the queue gets each frame (seconds)
+             */
+            double get_budget() const {
+                return this->budget;
+            }
+            /** Set how much time the queue gets each frame
+             * \param budget How much time the queue gets each frame (seconds; 0.0005 is 500 microseconds)
+             */
+            void set_budget(const double &budget) {
+                this->budget = budget < 0 ? 0 : budget;
+            }
+            /** Get how many frames a task can go without running before it gets a guaranteed chunk
+             * \returns How many frames a task can go without running before it gets a guaranteed chunk (0 means starvation protection is disabled)
+             */
+            unsigned int get_starvation_limit() const {
+                return this->starvation_limit;
+            }
+            /** Set how many frames a task can go without running before it gets a guaranteed chunk
+             * \param starvation_limit How many frames a task can go without running before it gets a guaranteed chunk (0 to disable starvation protection)
+             */
+            void set_starvation_limit(const unsigned int &starvation_limit) {
+                this->starvation_limit = starvation_limit;
+            }
+
+            /** Get how many tasks haven't finished yet
+             * \returns How many tasks haven't finished yet
+             */
+            std::size_t get_size() const {
+                return std::count_if(this->entries.begin(), this->entries.end(), [](const bengine::work_queue::entry &entry) {
+                    return !entry.cancelled;
+                });
+            }
+            /** Get whether every task has finished
+             * \returns Whether every task has finished
+             */
+            bool is_empty() const {
+                return this->get_size() == 0;
+            }
+            /** Get how many chunks were run during the most recent frame
+             * \returns How many chunks were run during the most recent frame
+             */
+            unsigned int get_steps_run() const {
+                return this->steps_run;
+            }
+
+            /** Spend up to the frame's budget running tasks (called once per frame by bengine::loop after the computation steps)
+             * \returns How long was spent running tasks (seconds); can go over the budget by the length of one chunk, plus one chunk for each starving task
+             */
+            double run() {
+                const Uint64 start = bengine::precision_clock::now();
+                const Uint64 budget_ticks = bengine::precision_clock::to_ticks(this->budget);
+                this->frame++;
+                this->steps_run = 0;
+                if (this->entries.empty()) {
+                    return 0.0;
+                }
+
+                // Starving tasks get their guaranteed chunk first, oldest first
+                std::vector<unsigned long long> starving;
+                for (std::size_t i = 0; i < this->entries.size(); i++) {
+                    if (this->is_starving(this->entries[i])) {
+                        starving.emplace_back(this->entries[i].id);
+                    }
+                }
+                for (std::size_t i = 0; i < starving.size(); i++) {
+                    for (std::size_t j = 0; j < this->entries.size(); j++) {
+                        if (this->entries[j].id == starving[i]) {
+                            this->step(j);
+                            break;
+                        }
+                    }
+                }
+
+                // Everything else goes by priority and then by age; a stable sort keeps it cheap when the order hasn't changed
+                std::stable_sort(this->entries.begin(), this->entries.end(), [](const bengine::work_queue::entry &a, const bengine::work_queue::entry &b) {
+                    return a.priority != b.priority ? a.priority > b.priority : a.id < b.id;
+                });
+                while (!this->entries.empty() && bengine::precision_clock::now() - start < budget_ticks) {
+                    this->step(0);
+                }
+
+                return bengine::precision_clock::seconds_since(start);
+            }
+    };
+}
+
+#endif // BENGINE_WORK_QUEUE_hpp
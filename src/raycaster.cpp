@@ -167,7 +167,7 @@ class raycaster : public bengine::loop {
         } keybinds;
 
         bengine::basic_texture minimap_texture;
-        TTF_Font *font = TTF_OpenFont("dev/fonts/GNU-Unifont.ttf", 20);
+        bengine::font font{"dev/fonts/GNU-Unifont.ttf", 20};
 
         std::vector<std::vector<Uint8>> grid;
 
@@ -297,8 +297,8 @@ class raycaster : public bengine::loop {
         }
 
         void create_minimap_texture() {
-            this->window.target_renderer_at_dummy();
-            this->window.initialize_dummy(this->grid.at(0).size() * minimap_cell_size, this->grid.size() * minimap_cell_size);
+            const unsigned int minimap_target = this->window.acquire_render_target(this->grid.at(0).size() * minimap_cell_size, this->grid.size() * minimap_cell_size, SDL_PIXELFORMAT_UNKNOWN, false);
+            this->window.push_render_target(minimap_target);
             this->window.clear_renderer();
 
             for (std::size_t row = 0; row < this->grid.size(); row++) {
@@ -308,11 +308,10 @@ class raycaster : public bengine::loop {
                     }
                 }
             }
-            this->window.present_renderer();
+            this->window.pop_render_target();
 
-            this->minimap_texture.set_texture(this->window.duplicate_dummy());
-            this->window.target_renderer_at_window();
-            this->window.clear_renderer();
+            // The minimap is only drawn once, so its texture is handed straight to minimap_texture rather than copied
+            this->minimap_texture.set_texture(this->window.detach_render_target(minimap_target));
         }
         void render() override {
             std::vector<std::optional<bengine::coordinate_2d<double>>> raycast_collisions;
@@ -328,9 +327,10 @@ class raycaster : public bengine::loop {
 
                 const unsigned char rectangle_brightness = btils::map_value_to_range<double, unsigned char>(distance, 0, player.get_view_distance(), 255, 0);
                 const int rectangle_height = btils::map_value_to_range<double, int>(distance, 0, player.get_view_distance(), this->window.get_height(), 0);
-                this->window.fill_rectangle(raycast_collisions.size(), this->window.get_height_2() - rectangle_height / 2, 1, rectangle_height, {rectangle_brightness, rectangle_brightness, rectangle_brightness, 255});
+                this->window.batch_filled_rectangle(raycast_collisions.size(), this->window.get_height_2() - rectangle_height / 2, 1, rectangle_height, {rectangle_brightness, rectangle_brightness, rectangle_brightness, 255});
             }
             this->hitscanner.set_angle(original_hitscanner_angle);
+            this->window.flush_primitive_batch();
 
             // Minimap rendering
             if (bengine::bitwise_manipulator::get_bit_state<Uint8>(this->minimap_settings, 0)) {
@@ -362,20 +362,21 @@ class raycaster : public bengine::loop {
                     if (raycast_collisions.at(i).has_value()) {
                         if (minimap_player.get_x_pos() + (raycast_collisions.at(i).value().get_x_pos() - this->player.get_x_pos()) * minimap_scale_factor < 0 || minimap_player.get_x_pos() + (raycast_collisions.at(i).value().get_x_pos() - this->player.get_x_pos()) * minimap_scale_factor > this->minimap_side_length || minimap_player.get_y_pos() + (raycast_collisions.at(i).value().get_y_pos() - this->player.get_y_pos()) * minimap_scale_factor < 0 || minimap_player.get_y_pos() + (raycast_collisions.at(i).value().get_y_pos() - this->player.get_y_pos()) * minimap_scale_factor > this->minimap_side_length) {
                             const double angle = this->hitscanner.get_angle() - this->player.get_fov() / 2 + i * this->player.get_fov() / this->window.get_width();
-                            this->window.draw_line(minimap_x_pos + minimap_player.get_x_pos(), minimap_y_pos + minimap_player.get_y_pos(), minimap_x_pos + minimap_player.get_x_pos() + view_distance * std::cos(angle) * minimap_scale_factor, minimap_y_pos + minimap_player.get_y_pos() + view_distance * std::sin(angle) * minimap_scale_factor, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::LIGHT_GRAY));
+                            this->window.batch_line(minimap_x_pos + minimap_player.get_x_pos(), minimap_y_pos + minimap_player.get_y_pos(), minimap_x_pos + minimap_player.get_x_pos() + view_distance * std::cos(angle) * minimap_scale_factor, minimap_y_pos + minimap_player.get_y_pos() + view_distance * std::sin(angle) * minimap_scale_factor, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::LIGHT_GRAY));
                         } else {
-                            this->window.draw_line(minimap_x_pos + minimap_player.get_x_pos(), minimap_y_pos + minimap_player.get_y_pos(), minimap_x_pos + minimap_player.get_x_pos() + (raycast_collisions.at(i).value().get_x_pos() - this->player.get_x_pos()) * minimap_scale_factor, minimap_y_pos + minimap_player.get_y_pos() + (raycast_collisions.at(i).value().get_y_pos() - this->player.get_y_pos()) * minimap_scale_factor, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::LIGHT_GRAY));
+                            this->window.batch_line(minimap_x_pos + minimap_player.get_x_pos(), minimap_y_pos + minimap_player.get_y_pos(), minimap_x_pos + minimap_player.get_x_pos() + (raycast_collisions.at(i).value().get_x_pos() - this->player.get_x_pos()) * minimap_scale_factor, minimap_y_pos + minimap_player.get_y_pos() + (raycast_collisions.at(i).value().get_y_pos() - this->player.get_y_pos()) * minimap_scale_factor, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::LIGHT_GRAY));
                         }
                     } else {
                         if (this->hitscanner.get_range() >= 0) {
                             const double angle = this->hitscanner.get_angle() - this->player.get_fov() / 2 + i * this->player.get_fov() / this->window.get_width();
-                            this->window.draw_line(minimap_x_pos + minimap_player.get_x_pos(), minimap_y_pos + minimap_player.get_y_pos(), minimap_x_pos + minimap_player.get_x_pos() + view_distance * std::cos(angle) * minimap_scale_factor, minimap_y_pos + minimap_player.get_y_pos() + view_distance * std::sin(angle) * minimap_scale_factor, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::DARK_GRAY));
+                            this->window.batch_line(minimap_x_pos + minimap_player.get_x_pos(), minimap_y_pos + minimap_player.get_y_pos(), minimap_x_pos + minimap_player.get_x_pos() + view_distance * std::cos(angle) * minimap_scale_factor, minimap_y_pos + minimap_player.get_y_pos() + view_distance * std::sin(angle) * minimap_scale_factor, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::DARK_GRAY));
                         }
                     }
                 }
 
                 minimap_player.set_radius(this->player.get_radius() * (this->minimap_side_length / (2 * view_distance * this->minimap_cell_size)) * this->minimap_cell_size);
-                this->window.fill_rectangle(minimap_x_pos + minimap_player.get_x_pos() - minimap_player.get_radius(), minimap_y_pos + minimap_player.get_y_pos() - minimap_player.get_radius(), minimap_player.get_radius() * 2, minimap_player.get_radius() * 2, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::RED));
+                this->window.batch_filled_rectangle(minimap_x_pos + minimap_player.get_x_pos() - minimap_player.get_radius(), minimap_y_pos + minimap_player.get_y_pos() - minimap_player.get_radius(), minimap_player.get_radius() * 2, minimap_player.get_radius() * 2, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::RED), 1);
+                this->window.flush_primitive_batch();
             }
 
             // Debug screen rendering
@@ -385,21 +386,21 @@ class raycaster : public bengine::loop {
                 this->window.render_SDLTexture(this->minimap_texture.get_texture(), {0, 0, (int)(this->grid.at(0).size() * this->minimap_cell_size), (int)(this->grid.size() * this->minimap_cell_size)}, {50, 50, (int)(this->grid.at(0).size() * this->minimap_cell_size), (int)(this->grid.size() * this->minimap_cell_size)});
             
                 for (std::size_t i = 0; i < this->colliders.size(); i++) {
-                    this->window.draw_rectangle(51 + this->colliders.at(i).get_left_x() * this->minimap_cell_size, 51 + this->colliders.at(i).get_bottom_y() * this->minimap_cell_size, this->colliders.at(i).get_width() * this->minimap_cell_size - 2, this->colliders.at(i).get_height() * this->minimap_cell_size - 2, {255, 0, 0, 255});
+                    this->window.batch_rectangle(51 + this->colliders.at(i).get_left_x() * this->minimap_cell_size, 51 + this->colliders.at(i).get_bottom_y() * this->minimap_cell_size, this->colliders.at(i).get_width() * this->minimap_cell_size - 2, this->colliders.at(i).get_height() * this->minimap_cell_size - 2, {255, 0, 0, 255});
                 }
 
                 for (std::size_t i = 0; i < raycast_collisions.size(); i++) {
                     if (raycast_collisions.at(i).has_value()) {
-                        this->window.draw_line(50 + this->hitscanner.get_x_pos() * this->minimap_cell_size, 50 + this->hitscanner.get_y_pos() * this->minimap_cell_size, 50 + raycast_collisions.at(i).value().get_x_pos() * this->minimap_cell_size, 50 + raycast_collisions.at(i).value().get_y_pos() * this->minimap_cell_size, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::LIME));
+                        this->window.batch_line(50 + this->hitscanner.get_x_pos() * this->minimap_cell_size, 50 + this->hitscanner.get_y_pos() * this->minimap_cell_size, 50 + raycast_collisions.at(i).value().get_x_pos() * this->minimap_cell_size, 50 + raycast_collisions.at(i).value().get_y_pos() * this->minimap_cell_size, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::LIME));
                     } else {
                         if (this->hitscanner.get_range() >= 0) {
                             const double angle = this->hitscanner.get_angle() - this->player.get_fov() / 2 + i * this->player.get_fov() / this->window.get_width();
-                            this->window.draw_line(50 + this->hitscanner.get_x_pos() * this->minimap_cell_size, 50 + this->hitscanner.get_y_pos() * this->minimap_cell_size, 50 + this->hitscanner.get_x_pos() * this->minimap_cell_size + this->hitscanner.get_range() * std::cos(angle) * this->minimap_cell_size, 50 + this->hitscanner.get_y_pos() * this->minimap_cell_size + this->hitscanner.get_range() * std::sin(angle) * this->minimap_cell_size, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::GREEN));
+                            this->window.batch_line(50 + this->hitscanner.get_x_pos() * this->minimap_cell_size, 50 + this->hitscanner.get_y_pos() * this->minimap_cell_size, 50 + this->hitscanner.get_x_pos() * this->minimap_cell_size + this->hitscanner.get_range() * std::cos(angle) * this->minimap_cell_size, 50 + this->hitscanner.get_y_pos() * this->minimap_cell_size + this->hitscanner.get_range() * std::sin(angle) * this->minimap_cell_size, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::GREEN));
                         }
                     }
                 }
 
-                this->window.fill_rectangle(50 + (this->player.get_x_pos() - this->player.get_radius()) * this->minimap_cell_size, 50 + (this->player.get_y_pos() - this->player.get_radius()) * this->minimap_cell_size, this->player.get_radius() * this->minimap_cell_size * 2, this->player.get_radius() * this->minimap_cell_size * 2, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::RED));
+                this->window.batch_filled_rectangle(50 + (this->player.get_x_pos() - this->player.get_radius()) * this->minimap_cell_size, 50 + (this->player.get_y_pos() - this->player.get_radius()) * this->minimap_cell_size, this->player.get_radius() * this->minimap_cell_size * 2, this->player.get_radius() * this->minimap_cell_size * 2, bengine::render_window::get_color_from_preset(bengine::render_window::preset_color::RED), 1);
             }
         }
 
@@ -527,9 +528,7 @@ class raycaster : public bengine::loop {
             this->player.set_movespeed(0.25);
             this->hitscanner = bengine::hitscanner_2d(this->player.get_x_pos(), this->player.get_y_pos(), 0, this->player.get_view_distance(), false);
         }
-        ~raycaster() {
-            TTF_CloseFont(this->font);
-        }
+        ~raycaster() {}
 };
 
 int main(int argc, char* args[]) {
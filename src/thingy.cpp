@@ -247,9 +247,12 @@ class projectile_and_movement_demo : public bengine::loop {
             int orbit_mouse_cw = SDL_SCANCODE_DOWN;
         } keybinds;
 
-        bengine::modded_texture fella_texture = bengine::modded_texture(this->window.load_texture("dev/thingy/gfx/smile.png"), {0, 0, 64, 64}, {255, 0, 0, 255});
+        // The textures are loaded in the background and belong to texture_loads, which hands out a placeholder until they're ready
+        unsigned int fella_texture_load = this->texture_loads.request("dev/thingy/gfx/smile.png");
+        bengine::modded_texture fella_texture = bengine::modded_texture(NULL, {0, 0, 64, 64}, {255, 0, 0, 255});
         bengine::click_rectangle fella_box;
-        bengine::basic_texture tile = bengine::basic_texture(this->window.load_texture("dev/thingy/gfx/tile.png"), {0, 0, 64, 64});
+        unsigned int tile_load = this->texture_loads.request("dev/thingy/gfx/tile.png");
+        bengine::basic_texture tile = bengine::basic_texture(NULL, {0, 0, 64, 64});
 
         bengine::coordinate_2d<double> fella_position;
         double fella_speed = 0.25;
@@ -327,6 +330,8 @@ class projectile_and_movement_demo : public bengine::loop {
                     previous_y = current_y;
                 }
             }
+            this->fella_texture.set_texture(this->texture_loads.get_texture(this->fella_texture_load));
+            this->tile.set_texture(this->texture_loads.get_texture(this->tile_load));
             this->window.render_modded_texture(this->fella_texture, {this->fella_box.get_x1(), this->fella_box.get_y1(), this->fella_box.get_width(), this->fella_box.get_height()});
         }
 
@@ -335,6 +340,8 @@ class projectile_and_movement_demo : public bengine::loop {
             bengine::coordinate_2d<double>::set_reference_point(bengine::coordinate_2d<double>(this->window.get_width() / 2, this->window.get_height() / 2));
             this->fella_position = bengine::coordinate_2d<double>::get_reference_point();
             this->fella_box = bengine::click_rectangle(this->fella_position.get_x_pos() - this->fella_radius, this->fella_position.get_y_pos() - this->fella_radius, this->fella_position.get_x_pos() + this->fella_radius, this->fella_position.get_y_pos() + this->fella_radius);
+            this->fella_texture.set_ownership(false);
+            this->tile.set_ownership(false);
         }
 };
 
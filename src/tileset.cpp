@@ -1,5 +1,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -13,23 +15,33 @@ class autotiler_demo : public bengine::loop {
         SDL_Point prev_mouse_pos_grid = {0, 0};
 
         unsigned char tileset_number = 0;
-        std::vector<SDL_Texture*> tileset_textures = {
-            window.load_texture("dev/png/imperialPath/sheet4bit.png"),
-            window.load_texture("dev/png/imperialPath/sheet8bit.png"),
-            window.load_texture("dev/png/ironFence/sheet4bit.png"),
-            window.load_texture("dev/png/ironFence/sheet8bit.png")
-        };
+        // All of the tilesets are packed into one atlas so that every tile can go into the same sprite batch
+        bengine::texture_atlas tileset_atlas;
+        std::vector<bengine::basic_texture> tileset_textures;
 
         std::vector<std::vector<std::vector<char>>> grid;
         Uint16 cell_size = 40;
+        // Each cell is one world unit, so the camera's zoom is the cell size
+        bengine::camera_2d camera;
 
         bengine::autotiler tiler;
 
+        // Modifying a cell can change the tiles of its neighbors too, so the 3x3 block around it gets redrawn
+        void invalidate_cell(const int &x, const int &y) {
+            this->window.invalidate(this->camera.get_screen_rectangle(x - 1, y - 1, 3, 3));
+        }
+
+        // The camera turns window positions back into cells, so the mouse always lands in the cell that's drawn under it
+        SDL_Point get_cell_at(const int &x, const int &y) const {
+            const SDL_FPoint world_pos = this->camera.screen_to_world(x, y);
+            return {static_cast<int>(std::floor(world_pos.x)), static_cast<int>(std::floor(world_pos.y))};
+        }
+
         void handle_event() override {
             switch (this->event.type) {
                 case SDL_MOUSEMOTION:
                     this->mstate.update_motion(this->event);
-                    this->mouse_pos_grid = {this->mstate.get_x_pos() / this->cell_size, this->mstate.get_y_pos() / this->cell_size};
+                    this->mouse_pos_grid = this->get_cell_at(this->mstate.get_x_pos(), this->mstate.get_y_pos());
                     break;
                 case SDL_MOUSEBUTTONDOWN:
                     this->mstate.press_button(this->event);
@@ -39,7 +51,7 @@ class autotiler_demo : public bengine::loop {
                         } else {
                             this->tiler.modify_8_bit_grid(grid[this->tileset_number], this->mouse_pos_grid.x, this->mouse_pos_grid.y, this->event.button.button == SDL_BUTTON_LEFT, false);
                         }
-                        this->visuals_changed = true;
+                        this->invalidate_cell(this->mouse_pos_grid.x, this->mouse_pos_grid.y);
                     }
                     break;
                 case SDL_MOUSEBUTTONUP:
@@ -57,6 +69,7 @@ class autotiler_demo : public bengine::loop {
                                     this->grid[this->tileset_number][i][j] = -1;
                                 }
                             }
+                            // Nothing is invalidated, so the whole window gets redrawn
                             this->visuals_changed = true;
                         }
                     }
@@ -73,26 +86,46 @@ class autotiler_demo : public bengine::loop {
                     } else {
                         this->tiler.modify_8_bit_grid(this->grid[this->tileset_number], this->mouse_pos_grid.x, this->mouse_pos_grid.y, this->mstate.pressed(bengine::generic_mouse_state::button_names::LEFT_MOUSE_BUTTON), false);
                     }
-                    this->visuals_changed = true;
+                    this->invalidate_cell(this->mouse_pos_grid.x, this->mouse_pos_grid.y);
                 }
             }
 
             this->mstate.stop_motion();
+            // Everything in the editor is driven by events, so there's no reason to keep stepping until the next one arrives
+            this->simulation_idle = true;
         }
         void render() override {
-            // Background stuff
+            // Background stuff (the renderer is clipped to the dirty region, so the fill only touches what's being redrawn)
             this->window.fill_rectangle(0, 0, this->window.get_width(), this->window.get_height(), bengine::render_window::preset_colors[static_cast<Uint8>(bengine::render_window::preset_color::WHITE)]);
-            for (std::size_t i = 0; i < this->grid.at(0).size(); i++) {
-                for (std::size_t j = 0; j < this->grid.at(0).at(i).size(); j++) {
-                    this->window.draw_rectangle(j * this->cell_size, i * this->cell_size, this->cell_size, this->cell_size, bengine::render_window::preset_colors[static_cast<Uint8>(bengine::render_window::preset_color::BLACK)]);
+
+            // Only the cells that the camera can see are looked at
+            double view_left, view_top, view_right, view_bottom;
+            this->camera.get_view_bounds(view_left, view_top, view_right, view_bottom);
+            const std::size_t first_row = static_cast<std::size_t>(std::max(0.0, std::floor(view_top)));
+            const std::size_t last_row = std::min(this->grid.at(0).size(), static_cast<std::size_t>(std::max(0.0, std::ceil(view_bottom))));
+            const std::size_t first_col = static_cast<std::size_t>(std::max(0.0, std::floor(view_left)));
+            const std::size_t last_col = std::min(this->grid.at(0).at(0).size(), static_cast<std::size_t>(std::max(0.0, std::ceil(view_right))));
+
+            for (std::size_t i = first_row; i < last_row; i++) {
+                for (std::size_t j = first_col; j < last_col; j++) {
+                    const SDL_Rect cell = this->camera.get_screen_rectangle(j, i, 1, 1);
+                    if (!this->window.needs_redraw(cell.x, cell.y, cell.w, cell.h)) {
+                        continue;
+                    }
+                    this->window.draw_rectangle(this->camera, j, i, 1, 1, bengine::render_window::preset_colors[static_cast<Uint8>(bengine::render_window::preset_color::BLACK)]);
                 }
             }
 
             for (std::size_t i = 0; i < this->tileset_textures.size(); i++) {
-                for (std::size_t j = 0; j < grid.at(i).size(); j++) {
-                    for (std::size_t k = 0; k < grid.at(i).at(j).size(); k++) {
-                        if (grid.at(i).at(j).at(k) >= 0) {
-                            this->window.render_SDLTexture(this->tileset_textures.at(i), {this->grid.at(i).at(j).at(k) % (i % 2 == 0 ? 4 : 8) * 16, this->grid.at(i).at(j).at(k) / (i % 2 == 0 ? 4 : 8) * 16, 16, 16}, {(int)(k * this->cell_size), (int)(j * this->cell_size), this->cell_size, this->cell_size});
+                const SDL_Rect sheet_frame = this->tileset_textures.at(i).get_frame();
+                for (std::size_t j = first_row; j < last_row; j++) {
+                    for (std::size_t k = first_col; k < last_col; k++) {
+                        if (grid.at(i).at(j).at(k) < 0) {
+                            continue;
+                        }
+                        const SDL_Rect cell = this->camera.get_screen_rectangle(k, j, 1, 1);
+                        if (this->window.needs_redraw(cell.x, cell.y, cell.w, cell.h)) {
+                            this->window.batch_SDLTexture(this->camera, this->tileset_textures.at(i).get_texture(), {sheet_frame.x + this->grid.at(i).at(j).at(k) % (i % 2 == 0 ? 4 : 8) * 16, sheet_frame.y + this->grid.at(i).at(j).at(k) / (i % 2 == 0 ? 4 : 8) * 16, 16, 16}, k, j, 1, 1);
                         }
                     }
                 }
@@ -100,7 +133,19 @@ class autotiler_demo : public bengine::loop {
         }
 
     public:
-        autotiler_demo() : bengine::loop("Autotiler Demo", 1280, 720, SDL_WINDOW_SHOWN | SDL_WINDOW_UTILITY, IMG_INIT_PNG, false) {
+        autotiler_demo() : bengine::loop("Autotiler Demo", 1280, 720, SDL_WINDOW_SHOWN | SDL_WINDOW_UTILITY, IMG_INIT_PNG, false), camera(1280, 720, this->cell_size) {
+            this->camera.set_top_left(0, 0);
+            // Edits only ever touch a handful of cells, so there's no need to redraw the whole grid for each one
+            this->window.start_partial_redrawing();
+
+            const char *tileset_paths[] = {"dev/png/imperialPath/sheet4bit.png", "dev/png/imperialPath/sheet8bit.png", "dev/png/ironFence/sheet4bit.png", "dev/png/ironFence/sheet8bit.png"};
+            for (const char *path : tileset_paths) {
+                this->tileset_atlas.add(path, path);
+            }
+            this->window.build_texture_atlas(this->tileset_atlas);
+            for (const char *path : tileset_paths) {
+                this->tileset_textures.emplace_back(this->tileset_atlas.get(path));
+            }
             for (std::size_t i = 0; i < this->tileset_textures.size(); i++) {
                 grid.emplace_back();
                 for (Uint16 j = 0; j < this->window.get_height() / this->cell_size; j++) {
@@ -111,11 +156,7 @@ class autotiler_demo : public bengine::loop {
                 }
             }
         }
-        ~autotiler_demo() {
-            for (std::size_t i = 0; i < this->tileset_textures.size(); i++) {
-                SDL_DestroyTexture(this->tileset_textures[i]);
-            }
-        }
+        ~autotiler_demo() {}
 };
 
 int main(int argc, char* args[]) {